@@ -38,4 +38,7 @@
 
 - (CGSize)imageSizeForContainerSize:(CGSize)size;
 
+- (BOOL)shouldEnableAsset:(id<KITAssetDataSource>)asset atIndex:(NSUInteger)index inAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection;
+- (void)assetCollectionDidLoadAssets:(id<KITAssetCollectionDataSource>)assetCollection;
+
 @end
@@ -31,7 +31,15 @@
 
 + (NSBundle *)KITAssetsPickerBundle
 {
-    return [NSBundle bundleWithPath:[NSBundle KITAssetsPickerBundlePath]];
+    // resolving the bundle path hits the file system, and every image and string lookup goes through here
+    static NSBundle *bundle;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        bundle = [NSBundle bundleWithPath:[NSBundle KITAssetsPickerBundlePath]];
+    });
+    
+    return bundle;
 }
 
 + (NSString *)KITAssetsPickerBundlePath
@@ -30,4 +30,20 @@
 
 + (UIImage *)KITAssetsPickerImageNamed:(NSString *)name;
 
+/**
+ *  Decodes encoded image data directly to an image no larger than `maximumPixelSize` on its longer side,
+ *  without creating the full-resolution bitmap first. The orientation is applied to the pixels.
+ *
+ *  The bitmap takes at most `4 × maximumPixelSize²` bytes, about 7 MB for a 1334 pixel screen, whatever the
+ *  size of the original; a 48 MP photo decoded in full takes 192 MB.
+ *
+ *  Safe to call on a background queue.
+ *
+ *  @param data             The encoded image data.
+ *  @param maximumPixelSize The largest width or height in pixels, or `0` for the original size.
+ *
+ *  @return The decoded image, or `nil` if the data cannot be decoded.
+ */
++ (UIImage *)KITAssetsPickerImageWithData:(NSData *)data maximumPixelSize:(CGFloat)maximumPixelSize;
+
 @end
@@ -25,6 +25,7 @@
  */
 
 #import "UIImage+KITAssetsPickerController.h"
+#import <ImageIO/ImageIO.h>
 #import "NSBundle+KITAssetsPickerController.h"
 
 @implementation UIImage (KITAssetsPickerController)
@@ -39,4 +40,41 @@
     }
 }
 
++ (UIImage *)KITAssetsPickerImageWithData:(NSData *)data maximumPixelSize:(CGFloat)maximumPixelSize
+{
+    if (data.length == 0)
+        return nil;
+    
+    // the source must not cache a full-size decode of its own
+    NSDictionary *sourceOptions = @{(__bridge NSString *)kCGImageSourceShouldCache : @NO};
+    CGImageSourceRef source = CGImageSourceCreateWithData((__bridge CFDataRef)data, (__bridge CFDictionaryRef)sourceOptions);
+    
+    if (!source)
+        return nil;
+    
+    if (maximumPixelSize <= 0)
+    {
+        NSDictionary *properties = CFBridgingRelease(CGImageSourceCopyPropertiesAtIndex(source, 0, NULL));
+        maximumPixelSize = MAX([properties[(__bridge NSString *)kCGImagePropertyPixelWidth] doubleValue],
+                               [properties[(__bridge NSString *)kCGImagePropertyPixelHeight] doubleValue]);
+    }
+    
+    // decoders such as JPEG and HEIC scale while decoding, so only the target size is ever allocated
+    NSDictionary *options = @{(__bridge NSString *)kCGImageSourceCreateThumbnailFromImageAlways : @YES,
+                              (__bridge NSString *)kCGImageSourceCreateThumbnailWithTransform : @YES,
+                              (__bridge NSString *)kCGImageSourceShouldCacheImmediately : @YES,
+                              (__bridge NSString *)kCGImageSourceThumbnailMaxPixelSize : @(MAX(ceil(maximumPixelSize), 1))};
+    
+    CGImageRef imageRef = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)options);
+    CFRelease(source);
+    
+    if (!imageRef)
+        return nil;
+    
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:1 orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+    
+    return image;
+}
+
 @end
@@ -24,7 +24,6 @@
  
  */
 
-#import <PureLayout/PureLayout.h>
 #import "KITAssetCheckmark.h"
 #import "NSBundle+KITAssetsPickerController.h"
 #import "UIImage+KITAssetsPickerController.h"
@@ -35,8 +34,6 @@
 @property (nonatomic, strong) UIImageView *shadowImageView;
 @property (nonatomic, strong) UIImageView *checkmarkImageView;
 
-@property (nonatomic, assign) BOOL didSetupConstraints;
-
 @end
 
 @implementation KITAssetCheckmark
@@ -74,23 +71,28 @@
     [self addSubview:self.checkmarkImageView];
 }
 
-- (void)updateConstraints
+#pragma mark - Layout
+
+// Sized by the shadow image, so Auto Layout parents need no explicit size constraints.
+- (CGSize)intrinsicContentSize
 {
-    if (!self.didSetupConstraints)
-    {
-        CGSize size = [UIImage KITAssetsPickerImageNamed:@"CheckmarkShadow"].size;
-        
-        [NSLayoutConstraint autoSetPriority:UILayoutPriorityRequired forConstraints:^{
-            [self autoSetDimensionsToSize:size];
-        }];
-        
-        [self.shadowImageView autoPinEdgesToSuperviewEdgesWithInsets:UIEdgeInsetsZero];
-        [self.checkmarkImageView autoCenterInSuperview];
-        
-        self.didSetupConstraints = YES;
-    }
+    return self.shadowImageView.image.size;
+}
+
+- (CGSize)sizeThatFits:(CGSize)size
+{
+    return self.intrinsicContentSize;
+}
+
+- (void)layoutSubviews
+{
+    [super layoutSubviews];
+    
+    CGRect bounds = self.bounds;
     
-    [super updateConstraints];
+    self.shadowImageView.frame      = bounds;
+    self.checkmarkImageView.center  = CGPointMake(CGRectGetMidX(bounds) - CGRectGetMinX(bounds),
+                                                  CGRectGetMidY(bounds) - CGRectGetMinY(bounds));
 }
 
 @end
@@ -0,0 +1,86 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <Foundation/Foundation.h>
+
+
+
+/**
+ *  Posted by a data source on the main thread after its contents changed.
+ *
+ *  The object is the `KITAssetCollectionDataSource` that changed, already holding its new contents.
+ *  The user info holds a `KITAssetCollectionChangeSet` under `KITAssetCollectionChangeSetKey`; without one,
+ *  the picker reloads the collection.
+ */
+extern NSString * const KITAssetCollectionDidChangeNotification;
+
+extern NSString * const KITAssetCollectionChangeSetKey;
+
+
+
+/**
+ *  Describes how a collection changed, so the grid can animate the difference instead of reloading.
+ *
+ *  Indexes follow `UICollectionView` batch update semantics: removed indexes and move sources refer to the
+ *  collection before the change, inserted indexes, changed indexes and move destinations to the collection after it.
+ */
+@interface KITAssetCollectionChangeSet : NSObject
+
+/**
+ *  A change set that only says the collection changed, which makes the picker reload it.
+ */
++ (instancetype)changeSetForReload;
+
+/**
+ *  Creates a change set.
+ *
+ *  @param removedIndexes  The indexes removed, before the change.
+ *  @param insertedIndexes The indexes inserted, after the change.
+ *  @param changedIndexes  The indexes whose asset changed in place, after the change.
+ *  @param moves           Pairs of `@[from, to]` indexes, or `nil`.
+ */
+- (instancetype)initWithRemovedIndexes:(NSIndexSet *)removedIndexes
+                       insertedIndexes:(NSIndexSet *)insertedIndexes
+                        changedIndexes:(NSIndexSet *)changedIndexes
+                                 moves:(NSArray<NSArray<NSNumber *> *> *)moves;
+
+@property (nonatomic, assign, readonly) BOOL hasIncrementalChanges;
+
+@property (nonatomic, copy, readonly) NSIndexSet *removedIndexes;
+@property (nonatomic, copy, readonly) NSIndexSet *insertedIndexes;
+@property (nonatomic, copy, readonly) NSIndexSet *changedIndexes;
+
+/**
+ *  The assets that were removed, if the data source knows them. Removed assets are deselected.
+ */
+@property (nonatomic, copy) NSArray *removedObjects;
+
+@property (nonatomic, assign, readonly) BOOL hasMoves;
+
+- (void)enumerateMovesWithBlock:(void (^)(NSUInteger fromIndex, NSUInteger toIndex))block;
+
+@end
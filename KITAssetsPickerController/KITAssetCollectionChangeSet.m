@@ -0,0 +1,97 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetCollectionChangeSet.h"
+
+
+
+NSString * const KITAssetCollectionDidChangeNotification = @"KITAssetCollectionDidChangeNotification";
+NSString * const KITAssetCollectionChangeSetKey = @"KITAssetCollectionChangeSetKey";
+
+
+
+@interface KITAssetCollectionChangeSet ()
+
+@property (nonatomic, assign, readwrite) BOOL hasIncrementalChanges;
+
+@property (nonatomic, copy, readwrite) NSIndexSet *removedIndexes;
+@property (nonatomic, copy, readwrite) NSIndexSet *insertedIndexes;
+@property (nonatomic, copy, readwrite) NSIndexSet *changedIndexes;
+@property (nonatomic, copy) NSArray *moves;
+
+@end
+
+
+
+
+
+@implementation KITAssetCollectionChangeSet
+
++ (instancetype)changeSetForReload
+{
+    KITAssetCollectionChangeSet *changeSet = [[self alloc] initWithRemovedIndexes:nil insertedIndexes:nil changedIndexes:nil moves:nil];
+    changeSet.hasIncrementalChanges = NO;
+    
+    return changeSet;
+}
+
+- (instancetype)initWithRemovedIndexes:(NSIndexSet *)removedIndexes
+                       insertedIndexes:(NSIndexSet *)insertedIndexes
+                        changedIndexes:(NSIndexSet *)changedIndexes
+                                 moves:(NSArray<NSArray<NSNumber *> *> *)moves
+{
+    if (self = [super init])
+    {
+        _hasIncrementalChanges  = YES;
+        _removedIndexes         = (removedIndexes) ? [removedIndexes copy] : [NSIndexSet indexSet];
+        _insertedIndexes        = (insertedIndexes) ? [insertedIndexes copy] : [NSIndexSet indexSet];
+        _changedIndexes         = (changedIndexes) ? [changedIndexes copy] : [NSIndexSet indexSet];
+        _moves                  = (moves) ? [moves copy] : @[];
+    }
+    
+    return self;
+}
+
+- (BOOL)hasMoves
+{
+    return (self.moves.count > 0);
+}
+
+- (void)enumerateMovesWithBlock:(void (^)(NSUInteger, NSUInteger))block
+{
+    for (NSArray<NSNumber *> *move in self.moves)
+        block(move[0].unsignedIntegerValue, move[1].unsignedIntegerValue);
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p removed %@ inserted %@ changed %@ moves %lu>",
+            self.class, self,
+            self.removedIndexes, self.insertedIndexes, self.changedIndexes, (unsigned long)self.moves.count];
+}
+
+@end
@@ -25,6 +25,7 @@
  */
 
 #import <Foundation/Foundation.h>
+#import "KITAssetMetadata.h"
 
 @protocol KITAssetCollectionDataSource <NSObject, NSCopying, NSFastEnumeration>
 
@@ -33,4 +34,48 @@
 - (id)objectAtIndex:(NSUInteger)index;
 - (NSUInteger)indexOfObject:(id)obj;
 
+@optional
+/**
+ *  The objects in a range, fetched together
+ *
+ *  Implement this when fetching a window of assets at once is cheaper than one `objectAtIndex:` per asset,
+ *  such as one database query for the whole range.
+ *
+ *  @param range The range, within `count`
+ *
+ *  @return The objects in the range, in order
+ */
+- (NSArray *)objectsInRange:(NSRange)range;
+
+/**
+ *  Enumerates the objects in a range, fetched together
+ *
+ *  @param range The range, within `count`
+ *  @param block The block called for each object; set `stop` to `YES` to stop early
+ */
+- (void)enumerateObjectsInRange:(NSRange)range usingBlock:(void (^)(id obj, NSUInteger idx, BOOL *stop))block;
+
+/**
+ *  Fills metadata columns for a range of assets without creating the asset objects
+ *
+ *  Implement this when the metadata can be read in bulk, such as from a database table. Row `k` of each column
+ *  describes the asset at `range.location + k`. It is called on a background queue, so it must be thread-safe.
+ *
+ *  @param columns The columns to fill, each with room for `range.length` rows
+ *  @param range   The range, within `count`
+ */
+- (void)getMetadataColumns:(KITAssetMetadataColumns)columns inRange:(NSRange)range;
+
 @end
+
+
+
+/**
+ *  Returns the objects in a range of a collection, using the batched methods when the collection implements them.
+ */
+FOUNDATION_EXTERN NSArray *KITAssetCollectionObjectsInRange(id<KITAssetCollectionDataSource> collection, NSRange range);
+
+/**
+ *  Enumerates the objects in a range of a collection, using the batched methods when the collection implements them.
+ */
+FOUNDATION_EXTERN void KITAssetCollectionEnumerateObjectsInRange(id<KITAssetCollectionDataSource> collection, NSRange range, void (^block)(id obj, NSUInteger idx, BOOL *stop));
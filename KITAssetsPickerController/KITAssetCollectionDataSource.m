@@ -0,0 +1,87 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetCollectionDataSource.h"
+
+
+
+static NSRange KITAssetCollectionClampRange(id<KITAssetCollectionDataSource> collection, NSRange range)
+{
+    NSUInteger count = collection.count;
+    
+    if (range.location >= count)
+        return NSMakeRange(count, 0);
+    
+    return NSMakeRange(range.location, MIN(range.length, count - range.location));
+}
+
+NSArray *KITAssetCollectionObjectsInRange(id<KITAssetCollectionDataSource> collection, NSRange range)
+{
+    range = KITAssetCollectionClampRange(collection, range);
+    
+    if (range.length == 0)
+        return @[];
+    
+    if ([collection respondsToSelector:@selector(objectsInRange:)])
+        return [collection objectsInRange:range];
+    
+    NSMutableArray *objects = [NSMutableArray arrayWithCapacity:range.length];
+    
+    if ([collection respondsToSelector:@selector(enumerateObjectsInRange:usingBlock:)])
+    {
+        [collection enumerateObjectsInRange:range usingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+            [objects addObject:obj];
+        }];
+    }
+    else
+    {
+        for (NSUInteger index = range.location; index < NSMaxRange(range); index++)
+            [objects addObject:[collection objectAtIndex:index]];
+    }
+    
+    return objects;
+}
+
+void KITAssetCollectionEnumerateObjectsInRange(id<KITAssetCollectionDataSource> collection, NSRange range, void (^block)(id obj, NSUInteger idx, BOOL *stop))
+{
+    range = KITAssetCollectionClampRange(collection, range);
+    
+    if (range.length == 0)
+        return;
+    
+    if ([collection respondsToSelector:@selector(enumerateObjectsInRange:usingBlock:)])
+    {
+        [collection enumerateObjectsInRange:range usingBlock:block];
+        return;
+    }
+    
+    NSArray *objects = KITAssetCollectionObjectsInRange(collection, range);
+    BOOL stop = NO;
+    
+    for (NSUInteger offset = 0; offset < objects.count && !stop; offset++)
+        block(objects[offset], range.location + offset, &stop);
+}
@@ -0,0 +1,65 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+#import <Foundation/Foundation.h>
+
+
+
+/**
+ *  The core of `KITAssetCollectionDiffer`, in plain C over symbols rather than assets.
+ *
+ *  Each asset is replaced by a symbol, a small integer shared by equal assets and below `numberOfSymbols`.
+ *  Heckel's algorithm then pairs up old and new indexes in linear time: symbols that occur exactly once in
+ *  both snapshots are matched first, and the matches are extended to equal neighbours.
+ *
+ *  @param fromSymbols      The symbols of the old snapshot.
+ *  @param fromCount        The number of old symbols.
+ *  @param toSymbols        The symbols of the new snapshot.
+ *  @param toCount          The number of new symbols.
+ *  @param numberOfSymbols  One more than the largest symbol.
+ *  @param fromMatches      Receives the new index of each old index, or `NSNotFound` if it was removed.
+ *  @param toMatches        Receives the old index of each new index, or `NSNotFound` if it was inserted.
+ *
+ *  @return `YES` on success, `NO` if memory could not be allocated.
+ */
+BOOL KITAssetCollectionDiffMatch(const NSUInteger *fromSymbols, NSUInteger fromCount,
+                                 const NSUInteger *toSymbols, NSUInteger toCount,
+                                 NSUInteger numberOfSymbols,
+                                 NSUInteger *fromMatches, NSUInteger *toMatches);
+
+/**
+ *  Picks the matched new indexes that keep their place, in n log n.
+ *
+ *  They are the longest run of matches whose old indexes increase, so the remaining matches are the fewest
+ *  moves that reorder the old snapshot into the new one.
+ *
+ *  @param toMatches  The old index of each new index, as filled by `KITAssetCollectionDiffMatch`.
+ *  @param toCount    The number of new indexes.
+ *  @param stays      Receives `YES` for each new index that keeps its place, `NO` for moved and inserted ones.
+ *
+ *  @return `YES` on success, `NO` if memory could not be allocated.
+ */
+BOOL KITAssetCollectionDiffStays(const NSUInteger *toMatches, NSUInteger toCount, BOOL *stays);
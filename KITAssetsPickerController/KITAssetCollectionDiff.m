@@ -0,0 +1,187 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+#import "KITAssetCollectionDiff.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+
+
+// symbol table entry of Heckel's algorithm; counts saturate at 2 since only unique symbols matter
+typedef struct
+{
+    uint8_t fromCount;
+    uint8_t toCount;
+    NSUInteger fromIndex;
+} KITAssetCollectionDiffEntry;
+
+
+
+#pragma mark - Matching
+
+// passes 1 to 3: pairs up symbols that occur exactly once in both snapshots
+static BOOL KITAssetCollectionDiffMatchUnique(const NSUInteger *fromSymbols, NSUInteger fromCount,
+                                              const NSUInteger *toSymbols, NSUInteger toCount,
+                                              NSUInteger numberOfSymbols,
+                                              NSUInteger *fromMatches, NSUInteger *toMatches)
+{
+    KITAssetCollectionDiffEntry *entries = calloc(MAX(numberOfSymbols, 1), sizeof(KITAssetCollectionDiffEntry));
+    
+    if (!entries)
+        return NO;
+    
+    for (NSUInteger j = 0; j < toCount; j++)
+    {
+        KITAssetCollectionDiffEntry *entry = &entries[toSymbols[j]];
+        entry->toCount = MIN(entry->toCount + 1, 2);
+    }
+    
+    for (NSUInteger i = 0; i < fromCount; i++)
+    {
+        KITAssetCollectionDiffEntry *entry = &entries[fromSymbols[i]];
+        entry->fromCount = MIN(entry->fromCount + 1, 2);
+        entry->fromIndex = i;
+    }
+    
+    for (NSUInteger j = 0; j < toCount; j++)
+    {
+        KITAssetCollectionDiffEntry entry = entries[toSymbols[j]];
+        
+        if (entry.fromCount == 1 && entry.toCount == 1)
+        {
+            toMatches[j] = entry.fromIndex;
+            fromMatches[entry.fromIndex] = j;
+        }
+    }
+    
+    free(entries);
+    
+    return YES;
+}
+
+// passes 4 and 5: extends matches to equal neighbours, which pairs up repeated symbols next to unique ones
+static void KITAssetCollectionDiffMatchNeighbours(const NSUInteger *fromSymbols, NSUInteger fromCount,
+                                                  const NSUInteger *toSymbols, NSUInteger toCount,
+                                                  NSUInteger *fromMatches, NSUInteger *toMatches)
+{
+    for (NSUInteger j = 0; j + 1 < toCount; j++)
+    {
+        NSUInteger i = toMatches[j];
+        
+        if (i != NSNotFound && i + 1 < fromCount &&
+            toMatches[j + 1] == NSNotFound && fromMatches[i + 1] == NSNotFound &&
+            fromSymbols[i + 1] == toSymbols[j + 1])
+        {
+            toMatches[j + 1] = i + 1;
+            fromMatches[i + 1] = j + 1;
+        }
+    }
+    
+    for (NSUInteger j = toCount; j > 1; j--)
+    {
+        NSUInteger i = toMatches[j - 1];
+        
+        if (i != NSNotFound && i > 0 &&
+            toMatches[j - 2] == NSNotFound && fromMatches[i - 1] == NSNotFound &&
+            fromSymbols[i - 1] == toSymbols[j - 2])
+        {
+            toMatches[j - 2] = i - 1;
+            fromMatches[i - 1] = j - 2;
+        }
+    }
+}
+
+BOOL KITAssetCollectionDiffMatch(const NSUInteger *fromSymbols, NSUInteger fromCount,
+                                 const NSUInteger *toSymbols, NSUInteger toCount,
+                                 NSUInteger numberOfSymbols,
+                                 NSUInteger *fromMatches, NSUInteger *toMatches)
+{
+    for (NSUInteger i = 0; i < fromCount; i++)
+        fromMatches[i] = NSNotFound;
+    
+    for (NSUInteger j = 0; j < toCount; j++)
+        toMatches[j] = NSNotFound;
+    
+    if (!KITAssetCollectionDiffMatchUnique(fromSymbols, fromCount, toSymbols, toCount, numberOfSymbols, fromMatches, toMatches))
+        return NO;
+    
+    KITAssetCollectionDiffMatchNeighbours(fromSymbols, fromCount, toSymbols, toCount, fromMatches, toMatches);
+    
+    return YES;
+}
+
+
+#pragma mark - Moves
+
+BOOL KITAssetCollectionDiffStays(const NSUInteger *toMatches, NSUInteger toCount, BOOL *stays)
+{
+    NSUInteger *tails        = malloc(MAX(toCount, 1) * sizeof(NSUInteger));
+    NSUInteger *predecessors = malloc(MAX(toCount, 1) * sizeof(NSUInteger));
+    NSUInteger length = 0;
+    
+    if (!tails || !predecessors)
+    {
+        free(tails);
+        free(predecessors);
+        return NO;
+    }
+    
+    for (NSUInteger j = 0; j < toCount; j++)
+    {
+        NSUInteger i = toMatches[j];
+        stays[j] = NO;
+        
+        if (i == NSNotFound)
+            continue;
+        
+        // tails[k] is the new index ending the best increasing run of length k + 1
+        NSUInteger low = 0, high = length;
+        
+        while (low < high)
+        {
+            NSUInteger mid = low + (high - low) / 2;
+            
+            if (toMatches[tails[mid]] < i)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        
+        predecessors[j] = (low > 0) ? tails[low - 1] : NSNotFound;
+        tails[low] = j;
+        
+        if (low == length)
+            length++;
+    }
+    
+    for (NSUInteger j = (length > 0) ? tails[length - 1] : NSNotFound; j != NSNotFound; j = predecessors[j])
+        stays[j] = YES;
+    
+    free(predecessors);
+    free(tails);
+    
+    return YES;
+}
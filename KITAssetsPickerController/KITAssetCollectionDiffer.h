@@ -0,0 +1,69 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "KITAssetCollectionDataSource.h"
+#import "KITAssetCollectionChangeSet.h"
+
+
+
+/**
+ *  Computes change sets between two snapshots of a collection, for data sources that can only hand over
+ *  their new contents.
+ *
+ *  Assets are matched with `isEqual:` and `hash` using Heckel's algorithm, so the diff takes linear time apart
+ *  from picking the smallest set of moves. Assets that occur more than once are matched only next to
+ *  unique neighbours; the other copies are removed and inserted. `removedObjects` only lists assets that are
+ *  gone from the new snapshot, so such copies are not deselected.
+ */
+@interface KITAssetCollectionDiffer : NSObject
+
+/**
+ *  The change set turning `fromAssets` into `toAssets`. Safe to call on any thread.
+ */
++ (KITAssetCollectionChangeSet *)changeSetFromAssets:(NSArray *)fromAssets toAssets:(NSArray *)toAssets;
+
+/**
+ *  Computes the change set on a background queue and calls the handler on the main thread.
+ */
++ (void)changeSetFromAssets:(NSArray *)fromAssets
+                   toAssets:(NSArray *)toAssets
+          completionHandler:(void (^)(KITAssetCollectionChangeSet *changeSet))completionHandler;
+
+/**
+ *  Diffs two snapshots of a collection on a background queue, then on the main thread calls `updateHandler`,
+ *  where the data source switches to `toAssets`, and posts `KITAssetCollectionDidChangeNotification`.
+ *
+ *  Updates are applied in the order they are submitted, so each one should start from the snapshot the
+ *  previous one ended with.
+ */
++ (void)assetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+     didChangeFromAssets:(NSArray *)fromAssets
+                toAssets:(NSArray *)toAssets
+           updateHandler:(void (^)(void))updateHandler;
+
+@end
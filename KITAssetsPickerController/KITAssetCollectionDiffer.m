@@ -0,0 +1,173 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetCollectionDiffer.h"
+#import "KITAssetCollectionDiff.h"
+
+
+
+
+@implementation KITAssetCollectionDiffer
+
+#pragma mark - Diff
+
++ (KITAssetCollectionChangeSet *)changeSetFromAssets:(NSArray *)fromAssets toAssets:(NSArray *)toAssets
+{
+    NSUInteger fromCount = fromAssets.count;
+    NSUInteger toCount   = toAssets.count;
+    
+    NSUInteger *fromSymbols = malloc(MAX(fromCount, 1) * sizeof(NSUInteger));
+    NSUInteger *toSymbols   = malloc(MAX(toCount, 1) * sizeof(NSUInteger));
+    NSUInteger *fromMatches = malloc(MAX(fromCount, 1) * sizeof(NSUInteger));
+    NSUInteger *toMatches   = malloc(MAX(toCount, 1) * sizeof(NSUInteger));
+    BOOL *stays             = malloc(MAX(toCount, 1) * sizeof(BOOL));
+    
+    // the new snapshot is numbered first, so an old asset is still there exactly when its symbol is below this
+    NSUInteger numberOfToSymbols = 0;
+    NSUInteger numberOfSymbols   = 0;
+    
+    // values are symbols plus one, so that no symbol is stored as NULL
+    CFMutableDictionaryRef symbols = CFDictionaryCreateMutable(kCFAllocatorDefault, toCount, &kCFTypeDictionaryKeyCallBacks, NULL);
+    
+    for (NSUInteger j = 0; j < toCount; j++)
+        toSymbols[j] = [self symbolForAsset:toAssets[j] inSymbols:symbols numberOfSymbols:&numberOfSymbols];
+    
+    numberOfToSymbols = numberOfSymbols;
+    
+    for (NSUInteger i = 0; i < fromCount; i++)
+        fromSymbols[i] = [self symbolForAsset:fromAssets[i] inSymbols:symbols numberOfSymbols:&numberOfSymbols];
+    
+    CFRelease(symbols);
+    
+    KITAssetCollectionDiffMatch(fromSymbols, fromCount, toSymbols, toCount, numberOfSymbols, fromMatches, toMatches);
+    KITAssetCollectionDiffStays(toMatches, toCount, stays);
+    
+    NSMutableIndexSet *removedIndexes   = [NSMutableIndexSet new];
+    NSMutableIndexSet *insertedIndexes  = [NSMutableIndexSet new];
+    NSMutableArray *removedObjects      = [NSMutableArray new];
+    NSMutableArray *moves               = [NSMutableArray new];
+    
+    for (NSUInteger i = 0; i < fromCount; i++)
+    {
+        if (fromMatches[i] != NSNotFound)
+            continue;
+        
+        [removedIndexes addIndex:i];
+        
+        // an unmatched copy of an asset that is still in the collection is not deselected
+        if (fromSymbols[i] >= numberOfToSymbols)
+            [removedObjects addObject:fromAssets[i]];
+    }
+    
+    for (NSUInteger j = 0; j < toCount; j++)
+    {
+        if (toMatches[j] == NSNotFound)
+            [insertedIndexes addIndex:j];
+        else if (!stays[j])
+            [moves addObject:@[@(toMatches[j]), @(j)]];
+    }
+    
+    free(stays);
+    free(toMatches);
+    free(fromMatches);
+    free(toSymbols);
+    free(fromSymbols);
+    
+    KITAssetCollectionChangeSet *changeSet =
+    [[KITAssetCollectionChangeSet alloc] initWithRemovedIndexes:removedIndexes
+                                                insertedIndexes:insertedIndexes
+                                                 changedIndexes:nil
+                                                          moves:moves];
+    
+    changeSet.removedObjects = removedObjects;
+    
+    return changeSet;
+}
+
+// equal assets share a symbol
++ (NSUInteger)symbolForAsset:(id)asset inSymbols:(CFMutableDictionaryRef)symbols numberOfSymbols:(NSUInteger *)numberOfSymbols
+{
+    const void *value = NULL;
+    
+    if (CFDictionaryGetValueIfPresent(symbols, (__bridge const void *)asset, &value))
+        return (NSUInteger)value - 1;
+    
+    NSUInteger symbol = (*numberOfSymbols)++;
+    CFDictionarySetValue(symbols, (__bridge const void *)asset, (const void *)(symbol + 1));
+    
+    return symbol;
+}
+
+
+#pragma mark - Background diffing
+
++ (dispatch_queue_t)diffQueue
+{
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("ly.kite.KITAssetsPickerController.differ", DISPATCH_QUEUE_SERIAL);
+        dispatch_set_target_queue(queue, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0));
+    });
+    
+    return queue;
+}
+
++ (void)changeSetFromAssets:(NSArray *)fromAssets
+                   toAssets:(NSArray *)toAssets
+          completionHandler:(void (^)(KITAssetCollectionChangeSet *))completionHandler
+{
+    fromAssets = [fromAssets copy];
+    toAssets   = [toAssets copy];
+    
+    // the serial queue keeps completions in submission order
+    dispatch_async([self diffQueue], ^{
+        KITAssetCollectionChangeSet *changeSet = [self changeSetFromAssets:fromAssets toAssets:toAssets];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completionHandler(changeSet);
+        });
+    });
+}
+
++ (void)assetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+     didChangeFromAssets:(NSArray *)fromAssets
+                toAssets:(NSArray *)toAssets
+           updateHandler:(void (^)(void))updateHandler
+{
+    [self changeSetFromAssets:fromAssets toAssets:toAssets completionHandler:^(KITAssetCollectionChangeSet *changeSet) {
+        if (updateHandler)
+            updateHandler();
+        
+        [[NSNotificationCenter defaultCenter] postNotificationName:KITAssetCollectionDidChangeNotification
+                                                            object:assetCollection
+                                                          userInfo:@{KITAssetCollectionChangeSetKey : changeSet}];
+    }];
+}
+
+@end
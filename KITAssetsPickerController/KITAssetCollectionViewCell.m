@@ -289,6 +289,10 @@
         NSNumberFormatter *nf = [NSNumberFormatter new];
         [self.countLabel setText:[nf KITAssetsPickerStringFromAssetsCount:count]];
     }
+    else
+    {
+        [self.countLabel setText:nil];
+    }
     
     [self setNeedsUpdateConstraints];
     [self updateConstraintsIfNeeded];
@@ -300,6 +304,10 @@
 - (NSString *)accessibilityLabel
 {
     NSString *title = self.titleLabel.text;
+    
+    if (!self.countLabel.text)
+        return title;
+    
     NSString *count = [NSString stringWithFormat:KITAssetsPickerLocalizedString(@"%@ Photos", nil), self.countLabel.text];
     
     NSArray *labels = @[title, count];
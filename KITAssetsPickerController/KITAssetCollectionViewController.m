@@ -30,11 +30,18 @@
 #import "KITAssetCollectionViewController.h"
 #import "KITAssetCollectionViewCell.h"
 #import "KITAssetsGridViewController.h"
+#import "KITAssetThumbnailGenerator.h"
+#import "KITAsyncAssetCollectionDataSource.h"
+#import "KITAssetCollectionChangeSet.h"
 #import "NSBundle+KITAssetsPickerController.h"
 
 
 
 
+// remote-backed collections may take a while to count; a few run at once without flooding the system
+static const NSInteger KITAssetCollectionViewControllerMaxConcurrentCounts = 4;
+
+
 
 @interface KITAssetCollectionViewController()
 <KITAssetsGridViewControllerDelegate>
@@ -47,6 +54,11 @@
 @property (nonatomic, copy) NSArray *fetchResults;
 @property (nonatomic, copy) NSArray *assetCollections;
 
+@property (nonatomic, strong) NSMapTable *assetCounts;
+@property (nonatomic, strong) NSHashTable *countingAssetCollections;
+@property (nonatomic, strong) NSMapTable *assetCountGenerations;
+@property (nonatomic, strong) NSOperationQueue *countQueue;
+
 @property (nonatomic, strong) id<KITAssetCollectionDataSource> defaultAssetCollection;
 @property (nonatomic, assign) BOOL didShowDefaultAssetCollection;
 @property (nonatomic, assign) BOOL didSelectDefaultAssetCollection;
@@ -63,6 +75,20 @@
 {
     if (self = [super initWithStyle:UITableViewStylePlain])
     {
+        _assetCounts = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                             valueOptions:NSPointerFunctionsStrongMemory];
+        
+        _countingAssetCollections = [NSHashTable hashTableWithOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality];
+        
+        _assetCountGenerations = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                                       valueOptions:NSPointerFunctionsStrongMemory];
+        
+        _countQueue = [NSOperationQueue new];
+        _countQueue.maxConcurrentOperationCount = KITAssetCollectionViewControllerMaxConcurrentCounts;
+        
+        if ([_countQueue respondsToSelector:@selector(setQualityOfService:)])
+            _countQueue.qualityOfService = NSQualityOfServiceUtility;
+        
         [self addNotificationObserver];
     }
     
@@ -102,6 +128,7 @@
 
 - (void)dealloc
 {
+    [self.countQueue cancelAllOperations];
     [self removeNotificationObserver];
 }
 
@@ -178,15 +205,122 @@
 {
     NSMutableArray *assetCollections = [NSMutableArray new];
 
+        // albums not counted yet are shown, and removed once they turn out to be empty
         for (id<KITAssetCollectionDataSource> assetCollection in self.picker.collectionDataSources)
         {
-            NSInteger count = assetCollection.count;
+            NSUInteger count = [self countOfAssetCollection:assetCollection];
             
-            if (self.picker.showsEmptyAlbums || count > 0)
+            if (self.picker.showsEmptyAlbums || count != 0)
                 [assetCollections addObject:assetCollection];
         }
 
     self.assetCollections = [NSMutableArray arrayWithArray:assetCollections];
+    
+    for (id<KITAssetCollectionDataSource> assetCollection in self.picker.collectionDataSources)
+        [self countAssetCollectionIfNeeded:assetCollection];
+}
+
+
+#pragma mark - Asset counts
+
+// the cached count, or NSNotFound until the album has been counted
+- (NSUInteger)countOfAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+{
+    NSNumber *count = [self.assetCounts objectForKey:assetCollection];
+    return (count) ? count.unsignedIntegerValue : NSNotFound;
+}
+
+- (void)countAssetCollectionIfNeeded:(id<KITAssetCollectionDataSource>)assetCollection
+{
+    if ([self.assetCounts objectForKey:assetCollection] || [self.countingAssetCollections containsObject:assetCollection])
+        return;
+    
+    [self.countingAssetCollections addObject:assetCollection];
+    
+    NSUInteger generation = [self countGenerationOfAssetCollection:assetCollection];
+    __weak KITAssetCollectionViewController *weakSelf = self;
+    
+    // paged collections are only ever called on the main thread, and know their count without a fetch
+    if ([assetCollection conformsToProtocol:@protocol(KITAsyncAssetCollectionDataSource)])
+    {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf didCountAssets:assetCollection.count inAssetCollection:assetCollection generation:generation];
+        });
+        
+        return;
+    }
+    
+    [self.countQueue addOperationWithBlock:^{
+        NSUInteger count = assetCollection.count;
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf didCountAssets:count inAssetCollection:assetCollection generation:generation];
+        });
+    }];
+}
+
+// drops the cached count; a count still running for the old contents is ignored when it arrives
+- (void)recountAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+{
+    NSUInteger generation = [self countGenerationOfAssetCollection:assetCollection] + 1;
+    [self.assetCountGenerations setObject:@(generation) forKey:assetCollection];
+    
+    [self.assetCounts removeObjectForKey:assetCollection];
+    [self.countingAssetCollections removeObject:assetCollection];
+    [self countAssetCollectionIfNeeded:assetCollection];
+}
+
+- (NSUInteger)countGenerationOfAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+{
+    return [[self.assetCountGenerations objectForKey:assetCollection] unsignedIntegerValue];
+}
+
+- (void)didCountAssets:(NSUInteger)count inAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection generation:(NSUInteger)generation
+{
+    if (generation != [self countGenerationOfAssetCollection:assetCollection])
+        return;
+    
+    [self.countingAssetCollections removeObject:assetCollection];
+    
+    NSUInteger previousCount = [self countOfAssetCollection:assetCollection];
+    [self.assetCounts setObject:@(count) forKey:assetCollection];
+    
+    if (count == previousCount)
+        return;
+    
+    NSIndexPath *indexPath = [self indexPathForAssetCollection:assetCollection];
+    BOOL isShown = (self.picker.showsEmptyAlbums || count > 0);
+    
+    if (indexPath && isShown)
+    {
+        [self reloadRowAtIndexPath:indexPath];
+    }
+    else if (indexPath)
+    {
+        NSMutableArray *assetCollections = [NSMutableArray arrayWithArray:self.assetCollections];
+        [assetCollections removeObjectAtIndex:indexPath.row];
+        self.assetCollections = assetCollections;
+        
+        if (assetCollections.count > 0)
+            [self.tableView deleteRowsAtIndexPaths:@[indexPath] withRowAnimation:UITableViewRowAnimationFade];
+        else
+            [self reloadData];
+    }
+    else if (isShown)
+    {
+        [self updateAssetCollections];
+        [self reloadData];
+    }
+}
+
+- (void)reloadRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    BOOL isSelected = [self.tableView.indexPathForSelectedRow isEqual:indexPath];
+    
+    [self.tableView reloadRowsAtIndexPaths:@[indexPath] withRowAnimation:UITableViewRowAnimationNone];
+    
+    if (isSelected)
+        [self.tableView selectRowAtIndexPath:indexPath animated:NO scrollPosition:UITableViewScrollPositionNone];
 }
 
 
@@ -217,12 +351,18 @@
                selector:@selector(contentSizeCategoryChanged:)
                    name:UIContentSizeCategoryDidChangeNotification
                  object:nil];
+    
+    [center addObserver:self
+               selector:@selector(assetCollectionDidChange:)
+                   name:KITAssetCollectionDidChangeNotification
+                 object:nil];
 }
 
 - (void)removeNotificationObserver
 {
     [[NSNotificationCenter defaultCenter] removeObserver:self name:KITAssetsPickerSelectedAssetsDidChangeNotification object:nil];
     [[NSNotificationCenter defaultCenter] removeObserver:self name:UIContentSizeCategoryDidChangeNotification object:nil];
+    [[NSNotificationCenter defaultCenter] removeObserver:self name:KITAssetCollectionDidChangeNotification object:nil];
 }
 
 
@@ -278,6 +418,20 @@
 }
 
 
+#pragma mark - Asset collection changed
+
+- (void)assetCollectionDidChange:(NSNotification *)notification
+{
+    id<KITAssetCollectionDataSource> assetCollection = notification.object;
+    
+    if (![self.picker.collectionDataSources containsObject:assetCollection])
+        return;
+    
+    // the album is counted again, and its row refreshed or removed once the count is known
+    [self recountAssetCollection:assetCollection];
+}
+
+
 #pragma mark - Reload data
 
 - (void)reloadData
@@ -307,7 +461,7 @@
     NSUInteger count;
     
     if (self.picker.showsNumberOfAssets){
-        count = [collection count];
+        count = [self countOfAssetCollection:collection];
     }
     else
         count = NSNotFound;
@@ -329,8 +483,11 @@
 - (void)requestThumbnailsForCell:(KITAssetCollectionViewCell *)cell assetCollection:(id<KITAssetCollectionDataSource>)collection
 {
     NSUInteger count    = cell.thumbnailStacks.thumbnailViews.count;
-    NSArray *assets     = [self posterAssetsFromAssetCollection:collection count:count];
-//    CGSize targetSize   = [self.picker imageSizeForContainerSize:self.picker.assetCollectionThumbnailSize];
+    NSUInteger total    = [self countOfAssetCollection:collection];
+    
+    // posters wait for the count, which reloads the row
+    NSArray *assets     = (total != NSNotFound) ? [self posterAssetsFromAssetCollection:collection count:MIN(count, total)] : @[];
+    CGSize targetSize   = [self.picker imageSizeForContainerSize:self.picker.assetCollectionThumbnailSize];
     
     for (NSUInteger index = 0; index < count; index++)
     {
@@ -340,7 +497,7 @@
         if (index < assets.count)
         {
             id<KITAssetDataSource> asset = assets[index];
-            [asset thumbnailImageWithCompletionHandler:^(UIImage *image){
+            [[KITAssetThumbnailGenerator sharedGenerator] requestThumbnailForAsset:asset targetSize:targetSize completionHandler:^(UIImage *image){
                 [thumbnailView setHidden:NO];
                 [thumbnailView bind:image assetCollection:collection];
             }];
@@ -350,11 +507,29 @@
 
 - (NSArray *)posterAssetsFromAssetCollection:(id<KITAssetCollectionDataSource>)collection count:(NSUInteger)count;
 {
-    NSMutableArray *assets = [[NSMutableArray alloc] init];
-    for (NSInteger i = 0; i < MIN(count, collection.count); i++){
-        [assets addObject:[collection objectAtIndex:i]];
+    NSRange range = NSMakeRange(0, count);
+    
+    // paged collections load their first page, then the row is shown again
+    if ([collection conformsToProtocol:@protocol(KITAsyncAssetCollectionDataSource)])
+    {
+        id<KITAsyncAssetCollectionDataSource> asyncCollection = (id<KITAsyncAssetCollectionDataSource>)collection;
+        
+        if (range.length > 0 && ![asyncCollection areObjectsLoadedInRange:range])
+        {
+            __weak KITAssetCollectionViewController *weakSelf = self;
+            
+            [asyncCollection loadObjectsInRange:range completionHandler:^(NSError *error) {
+                NSIndexPath *indexPath = [weakSelf indexPathForAssetCollection:collection];
+                
+                if (!error && indexPath)
+                    [weakSelf reloadRowAtIndexPath:indexPath];
+            }];
+            
+            return @[];
+        }
     }
-    return assets;
+    
+    return KITAssetCollectionObjectsInRange(collection, range);
 }
 
 
@@ -429,13 +604,7 @@
 
 - (void)assetsGridViewController:(KITAssetsGridViewController *)picker photoLibraryDidChangeForAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
 {
-    NSIndexPath *indexPath = [self indexPathForAssetCollection:assetCollection];
-    
-    if (indexPath)
-    {
-        [self.tableView reloadRowsAtIndexPaths:@[indexPath] withRowAnimation:UITableViewRowAnimationNone];
-        [self.tableView selectRowAtIndexPath:indexPath animated:NO scrollPosition:UITableViewScrollPositionNone];
-    }
+    [self recountAssetCollection:assetCollection];
 }
 
 @end
\ No newline at end of file
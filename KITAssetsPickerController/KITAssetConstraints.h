@@ -0,0 +1,61 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "KITAssetMetadata.h"
+#import "KITAssetDataSource.h"
+
+
+
+/**
+ *  Declarative rules an asset has to meet to be enabled for selection.
+ *
+ *  Unlike `assetsPickerController:shouldEnableAsset:`, constraints are evaluated once per album in bulk on a
+ *  background queue, and the result is reused by the grid and the page view.
+ */
+@interface KITAssetConstraints : NSObject <NSCopying>
+
+/**
+ *  The smallest size in pixels an asset may have, in either orientation. Assets of unknown size pass.
+ *
+ *  The default value is `CGSizeZero`.
+ */
+@property (nonatomic, assign) CGSize minimumPixelSize;
+
+/**
+ *  The mime types allowed. Assets of unknown mime type pass only if it includes `KITAssetMimeTypeMaskUnknown`.
+ *
+ *  The default value is `KITAssetMimeTypeMaskAll`.
+ */
+@property (nonatomic, assign) KITAssetMimeTypeMask allowedMimeTypes;
+
+/**
+ *  Whether a single asset meets the constraints.
+ */
+- (BOOL)isSatisfiedByAsset:(id<KITAssetDataSource>)asset;
+
+@end
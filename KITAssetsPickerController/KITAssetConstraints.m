@@ -0,0 +1,69 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetConstraints.h"
+
+
+
+@implementation KITAssetConstraints
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        _minimumPixelSize   = CGSizeZero;
+        _allowedMimeTypes   = KITAssetMimeTypeMaskAll;
+    }
+    
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    KITAssetConstraints *constraints = [[self.class allocWithZone:zone] init];
+    constraints.minimumPixelSize = self.minimumPixelSize;
+    constraints.allowedMimeTypes = self.allowedMimeTypes;
+    
+    return constraints;
+}
+
+- (BOOL)isSatisfiedByAsset:(id<KITAssetDataSource>)asset
+{
+    CGFloat width   = asset.pixelWidth;
+    CGFloat height  = asset.pixelHeight;
+    
+    BOOL unknownSize = (MIN(width, height) <= 0);
+    BOOL largeEnough = (MIN(width, height) >= MIN(self.minimumPixelSize.width, self.minimumPixelSize.height) &&
+                        MAX(width, height) >= MAX(self.minimumPixelSize.width, self.minimumPixelSize.height));
+    
+    KITAssetMimeType mimeType = KITAssetMimeTypeFromString(asset.mimeType);
+    BOOL allowedType = ((self.allowedMimeTypes & (1 << mimeType)) != 0);
+    
+    return (unknownSize || largeEnough) && allowedType;
+}
+
+@end
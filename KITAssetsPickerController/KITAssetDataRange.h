@@ -0,0 +1,56 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+#import <Foundation/Foundation.h>
+
+
+
+/**
+ *  The byte range arithmetic and file reads behind `KITAssetDataReader` and `KITFileAssetDataSource`, in plain C.
+ */
+
+/**
+ *  The length of the next range to read.
+ *
+ *  @param offset         The offset of the next range.
+ *  @param expectedLength The total length, or `-1` if unknown.
+ *  @param chunkLength    The largest range to read at once.
+ *
+ *  @return The length to read, or `0` once the offset reaches the expected length.
+ */
+NSUInteger KITAssetDataRangeNextLength(long long offset, long long expectedLength, NSUInteger chunkLength);
+
+/**
+ *  Reads a range of a file into a buffer, retrying interrupted and partial reads.
+ *
+ *  @param path   The file system path of the file.
+ *  @param offset The offset of the first byte.
+ *  @param length The number of bytes to read.
+ *  @param bytes  The buffer, with room for `length` bytes.
+ *
+ *  @return The number of bytes read, fewer than `length` only at the end of the file, or `-1` with `errno` set.
+ */
+long long KITAssetDataRangeReadFile(const char *path, unsigned long long offset, NSUInteger length, void *bytes);
@@ -0,0 +1,85 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+#import "KITAssetDataRange.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+
+#pragma mark - Ranges
+
+NSUInteger KITAssetDataRangeNextLength(long long offset, long long expectedLength, NSUInteger chunkLength)
+{
+    if (expectedLength < 0)
+        return chunkLength;
+    
+    if (offset >= expectedLength)
+        return 0;
+    
+    return (NSUInteger)MIN((long long)chunkLength, expectedLength - offset);
+}
+
+
+#pragma mark - Files
+
+long long KITAssetDataRangeReadFile(const char *path, unsigned long long offset, NSUInteger length, void *bytes)
+{
+    int file = open(path, O_RDONLY);
+    
+    if (file < 0)
+        return -1;
+    
+    NSUInteger total = 0;
+    
+    while (total < length)
+    {
+        ssize_t count = pread(file, (char *)bytes + total, length - total, (off_t)(offset + total));
+        
+        if (count < 0 && errno == EINTR)
+            continue;
+        
+        if (count < 0)
+        {
+            int error = errno;
+            close(file);
+            errno = error;
+            
+            return -1;
+        }
+        
+        // the end of the file
+        if (count == 0)
+            break;
+        
+        total += (NSUInteger)count;
+    }
+    
+    close(file);
+    
+    return (long long)total;
+}
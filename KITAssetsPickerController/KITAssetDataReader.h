@@ -0,0 +1,72 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "KITAssetDataSource.h"
+
+
+
+/**
+ *  Reads the bytes of an asset in chunks, holding only one chunk at a time when the asset supports it.
+ *
+ *  Assets implementing `dataInRange:completionHandler:` are read range by range, each read starting when the
+ *  previous chunk has been handled. Assets implementing `dataWithProgressHandler:completionHandler:` pass their
+ *  own chunks through. Others are read whole and handed out in chunks.
+ */
+@interface KITAssetDataReader : NSObject
+
+- (instancetype)initWithAsset:(id<KITAssetDataSource>)asset;
+
+/**
+ *  The length of the chunks read by range. The default value is 256 KB.
+ */
+@property (nonatomic, assign) NSUInteger chunkLength;
+
+/**
+ *  Whether the asset delivers its bytes in chunks, rather than only as a whole.
+ */
++ (BOOL)assetSupportsChunkedReading:(id<KITAssetDataSource>)asset;
+
+/**
+ *  Reads every byte in order.
+ *
+ *  @param chunkHandler      Called for each chunk with its offset and the expected total length, or `-1` if unknown.
+ *  @param completionHandler Called once at the end, with an error if reading failed.
+ */
+- (void)readWithChunkHandler:(void (^)(NSData *chunk, long long offset, long long expectedLength))chunkHandler
+           completionHandler:(void (^)(NSError *error))completionHandler;
+
+/**
+ *  Reads the first bytes, such as to parse the header of the image.
+ *
+ *  Only assets implementing `dataInRange:completionHandler:` read just the prefix. Other assets are read to their
+ *  end: the handler is called as soon as the prefix has arrived, but the rest of the asset is still loaded, and
+ *  assets delivering their data only as a whole hold all of it in memory at once.
+ */
+- (void)readPrefixOfLength:(NSUInteger)length completionHandler:(void (^)(NSData *data, NSError *error))completionHandler;
+
+@end
@@ -0,0 +1,174 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetDataReader.h"
+#import "KITAssetDataRange.h"
+
+
+
+
+static const NSUInteger KITAssetDataReaderDefaultChunkLength = 256 * 1024;
+
+
+
+@interface KITAssetDataReader ()
+
+@property (nonatomic, strong) id<KITAssetDataSource> asset;
+
+@end
+
+
+
+
+
+@implementation KITAssetDataReader
+
+- (instancetype)initWithAsset:(id<KITAssetDataSource>)asset
+{
+    if (self = [super init])
+    {
+        _asset          = asset;
+        _chunkLength    = KITAssetDataReaderDefaultChunkLength;
+    }
+    
+    return self;
+}
+
++ (BOOL)assetSupportsChunkedReading:(id<KITAssetDataSource>)asset
+{
+    return ([asset respondsToSelector:@selector(dataInRange:completionHandler:)] ||
+            [asset respondsToSelector:@selector(dataWithProgressHandler:completionHandler:)]);
+}
+
+
+#pragma mark - Reading
+
+- (void)readWithChunkHandler:(void (^)(NSData *, long long, long long))chunkHandler
+           completionHandler:(void (^)(NSError *))completionHandler
+{
+    id<KITAssetDataSource> asset = self.asset;
+    
+    if ([asset respondsToSelector:@selector(dataInRange:completionHandler:)])
+    {
+        [asset dataLengthWithCompletionHandler:^(long long dataLength, NSError *error) {
+            if (error)
+                completionHandler(error);
+            else
+                [self readFromOffset:0 expectedLength:dataLength chunkHandler:chunkHandler completionHandler:completionHandler];
+        }];
+    }
+    else if ([asset respondsToSelector:@selector(dataWithProgressHandler:completionHandler:)])
+    {
+        __block long long offset = 0;
+        
+        [asset dataWithProgressHandler:^(NSData *chunk, long long expectedLength) {
+            chunkHandler(chunk, offset, expectedLength);
+            offset += chunk.length;
+        } completionHandler:^(NSData *data, NSError *error) {
+            completionHandler(error);
+        }];
+    }
+    else
+    {
+        NSUInteger chunkLength = self.chunkLength;
+        
+        [asset dataWithCompletionHandler:^(NSData *data, NSError *error) {
+            for (NSUInteger offset = 0; !error && offset < data.length; offset += chunkLength)
+            {
+                NSRange range = NSMakeRange(offset, MIN(chunkLength, data.length - offset));
+                chunkHandler([data subdataWithRange:range], offset, data.length);
+            }
+            
+            completionHandler(error);
+        }];
+    }
+}
+
+- (void)readFromOffset:(long long)offset
+        expectedLength:(long long)expectedLength
+          chunkHandler:(void (^)(NSData *, long long, long long))chunkHandler
+     completionHandler:(void (^)(NSError *))completionHandler
+{
+    NSUInteger length = KITAssetDataRangeNextLength(offset, expectedLength, self.chunkLength);
+    
+    if (length == 0)
+    {
+        completionHandler(nil);
+        return;
+    }
+    
+    [self.asset dataInRange:NSMakeRange((NSUInteger)offset, length) completionHandler:^(NSData *data, NSError *error) {
+        if (error)
+        {
+            completionHandler(error);
+            return;
+        }
+        
+        if (data.length > 0)
+            chunkHandler(data, offset, expectedLength);
+        
+        // a short read is the end of the data
+        if (data.length < length)
+            completionHandler(nil);
+        else
+            [self readFromOffset:offset + data.length expectedLength:expectedLength chunkHandler:chunkHandler completionHandler:completionHandler];
+    }];
+}
+
+- (void)readPrefixOfLength:(NSUInteger)length completionHandler:(void (^)(NSData *, NSError *))completionHandler
+{
+    id<KITAssetDataSource> asset = self.asset;
+    
+    if ([asset respondsToSelector:@selector(dataInRange:completionHandler:)])
+    {
+        [asset dataInRange:NSMakeRange(0, length) completionHandler:completionHandler];
+        return;
+    }
+    
+    // without range reads the asset is read to its end regardless; the prefix is handed over as soon as it is
+    // complete and the rest of the chunks are dropped as they arrive
+    NSMutableData *prefix = [NSMutableData new];
+    __block BOOL isComplete = NO;
+    
+    [self readWithChunkHandler:^(NSData *chunk, long long offset, long long expectedLength) {
+        if (isComplete)
+            return;
+        
+        [prefix appendData:[chunk subdataWithRange:NSMakeRange(0, MIN(chunk.length, length - prefix.length))]];
+        
+        if (prefix.length == length)
+        {
+            isComplete = YES;
+            completionHandler(prefix, nil);
+        }
+    } completionHandler:^(NSError *error) {
+        if (!isComplete)
+            completionHandler((error) ? nil : prefix, error);
+    }];
+}
+
+@end
@@ -49,12 +49,52 @@
  */
 - (void)dataWithCompletionHandler:(void(^)(NSData *data, NSError *error))handler;
 
-- (void)thumbnailImageWithCompletionHandler:(void(^)(UIImage *image))handler;
-
 - (CGFloat)pixelWidth;
 - (CGFloat)pixelHeight;
 
 @optional
+/**
+ *  A small image of the asset for the grid and the album list
+ *
+ *  When not implemented, the picker downsamples the image from `dataWithCompletionHandler:` itself.
+ *
+ *  @param handler Handler to provide the thumbnail asynchronously
+ */
+- (void)thumbnailImageWithCompletionHandler:(void(^)(UIImage *image))handler;
+
+/**
+ *  The date the asset was created
+ *
+ *  Used to group the grid into sections by day when `groupsAssetsByDate` is enabled on the picker.
+ *  It is called on the main thread, in batches, while the picker reads the dates of a collection.
+ *
+ *  @return The creation date, or `nil` if unknown
+ */
+- (NSDate *)creationDate;
+
+/**
+ *  The data of the image, delivered in chunks as it arrives
+ *
+ *  Implement this when the data is downloaded or read progressively. The page view then shows real progress
+ *  and renders what has arrived so far. When implemented, it is used instead of `dataWithCompletionHandler:`.
+ *
+ *  @param progressHandler   Called for each chunk, in order, with the expected total length or `-1` if unknown
+ *  @param completionHandler Called once at the end with the whole data, or with an error
+ */
+- (void)dataWithProgressHandler:(void(^)(NSData *chunk, long long expectedLength))progressHandler
+              completionHandler:(void(^)(NSData *data, NSError *error))completionHandler;
+
+/**
+ *  A range of the bytes of the image
+ *
+ *  Implement this when the bytes can be read at an offset, such as from a file or with HTTP range requests.
+ *  Consumers can then parse headers, decode and hash the image in bounded memory with `KITAssetDataReader`.
+ *
+ *  @param range   The range of bytes, within the length from `dataLengthWithCompletionHandler:`
+ *  @param handler Handler to provide the bytes asynchronously; fewer bytes than asked mean the end was reached
+ */
+- (void)dataInRange:(NSRange)range completionHandler:(void(^)(NSData *data, NSError *error))handler;
+
 /**
  *  Optional method to cancel loading of the image (for example downloading from the network)
  */
@@ -0,0 +1,54 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "KITAssetCollectionDataSource.h"
+#import "KITAssetConstraints.h"
+
+
+
+/**
+ *  One bit per asset of a collection, telling whether it meets a set of constraints.
+ */
+@interface KITAssetEnablementMap : NSObject
+
+/**
+ *  Reads the metadata of the collection as `KITAssetMetadataStore` does, evaluates the constraints on a background
+ *  queue, then calls the handler on the main thread. Call it on the main thread.
+ */
++ (void)buildEnablementMapForAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+                                 constraints:(KITAssetConstraints *)constraints
+                           completionHandler:(void (^)(KITAssetEnablementMap *enablementMap))handler;
+
+/**
+ *  The number of assets covered. Assets past it, such as pages loaded later, have to be checked one by one.
+ */
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+- (BOOL)isAssetEnabledAtIndex:(NSUInteger)index;
+
+@end
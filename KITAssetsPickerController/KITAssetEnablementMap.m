@@ -0,0 +1,102 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetEnablementMap.h"
+#import "KITAssetMetadataStore.h"
+
+
+
+@interface KITAssetEnablementMap ()
+
+@property (nonatomic, assign, readwrite) NSUInteger count;
+@property (nonatomic, assign) uint64_t *bits;
+
+@end
+
+
+
+
+
+@implementation KITAssetEnablementMap
+
++ (void)buildEnablementMapForAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+                                 constraints:(KITAssetConstraints *)constraints
+                           completionHandler:(void (^)(KITAssetEnablementMap *))handler
+{
+    constraints = [constraints copy];
+    
+    [KITAssetMetadataStore buildMetadataStoreForAssetCollection:assetCollection completionHandler:^(KITAssetMetadataStore *metadataStore) {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+            KITAssetEnablementMap *enablementMap = [[self alloc] initWithMetadataStore:metadataStore constraints:constraints];
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                handler(enablementMap);
+            });
+        });
+    }];
+}
+
+- (instancetype)initWithMetadataStore:(KITAssetMetadataStore *)metadataStore constraints:(KITAssetConstraints *)constraints
+{
+    if (self = [super init])
+    {
+        NSUInteger count = metadataStore.count;
+        uint8_t *flags = malloc(MAX(count, 1));
+        
+        [metadataStore evaluateMinimumPixelSize:constraints.minimumPixelSize
+                                      mimeTypes:constraints.allowedMimeTypes
+                                      intoFlags:flags];
+        
+        // packed to one bit per asset, so large albums stay small in memory
+        uint64_t *bits = calloc(MAX((count + 63) / 64, 1), sizeof(uint64_t));
+        
+        for (NSUInteger index = 0; index < count; index++)
+            bits[index / 64] |= (uint64_t)flags[index] << (index % 64);
+        
+        free(flags);
+        
+        _count  = count;
+        _bits   = bits;
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_bits);
+}
+
+- (BOOL)isAssetEnabledAtIndex:(NSUInteger)index
+{
+    if (index >= self.count)
+        return NO;
+    
+    return (self.bits[index / 64] >> (index % 64)) & 1;
+}
+
+@end
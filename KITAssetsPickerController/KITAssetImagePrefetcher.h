@@ -0,0 +1,72 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <UIKit/UIKit.h>
+#import "KITAssetDataSource.h"
+
+
+
+/**
+ *  Fetches and decodes the images of pages before they are shown, bounded to a pixel size.
+ *
+ *  Decoded images are kept in a cache whose cost is their size in bytes. Loads of assets that stop being
+ *  prefetched are cancelled unless a page is waiting for them. Use it from the main queue.
+ */
+@interface KITAssetImagePrefetcher : NSObject
+
+- (instancetype)initWithMaximumPixelSize:(CGFloat)maximumPixelSize;
+
+@property (nonatomic, assign, readonly) CGFloat maximumPixelSize;
+
+/**
+ *  The most bytes of decoded images to keep. The default value is `KITAssetsPagePrefetchCacheBytes`.
+ */
+@property (nonatomic, assign) NSUInteger totalCostLimit;
+
+/**
+ *  Prefetches the assets, nearest first, replacing any previous list.
+ *
+ *  @param assets The assets to prefetch, in order of priority.
+ */
+- (void)prefetchAssets:(NSArray *)assets;
+
+/**
+ *  Cancels every load no page is waiting for.
+ */
+- (void)stopPrefetching;
+
+/**
+ *  Looks up the image of an asset, waiting for its load if one is running.
+ *
+ *  @param asset   The asset to look up.
+ *  @param handler Called on the main queue with the image, or `nil` if the load failed. Called at once when cached.
+ *
+ *  @return `NO` if the asset is neither cached nor loading, in which case the handler is not called.
+ */
+- (BOOL)imageForAsset:(id<KITAssetDataSource>)asset completionHandler:(void (^)(UIImage *image))handler;
+
+@end
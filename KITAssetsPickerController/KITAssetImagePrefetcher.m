@@ -0,0 +1,219 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetImagePrefetcher.h"
+#import "KITAssetsPickerDefines.h"
+#import "KITAssetTiledImageView.h"
+#import "UIImage+KITAssetsPickerController.h"
+
+
+
+// loads beyond these wait, so the nearest pages come first
+static const NSUInteger KITAssetImagePrefetcherMaximumConcurrentLoads = 2;
+
+
+
+@interface KITAssetImagePrefetcher ()
+
+@property (nonatomic, assign, readwrite) CGFloat maximumPixelSize;
+
+@property (nonatomic, strong) NSCache *images;
+@property (nonatomic, strong) NSMutableArray *pendingAssets;
+@property (nonatomic, strong) NSMutableSet *loadingAssets;
+@property (nonatomic, strong) NSMapTable *waitingHandlers;
+
+@end
+
+
+
+
+
+@implementation KITAssetImagePrefetcher
+
+- (instancetype)initWithMaximumPixelSize:(CGFloat)maximumPixelSize
+{
+    if (self = [super init])
+    {
+        _maximumPixelSize   = maximumPixelSize;
+        _images             = [NSCache new];
+        _pendingAssets      = [NSMutableArray new];
+        _loadingAssets      = [NSMutableSet new];
+        _waitingHandlers    = [NSMapTable strongToStrongObjectsMapTable];
+        
+        self.totalCostLimit = KITAssetsPagePrefetchCacheBytes;
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    [self stopPrefetching];
+}
+
+
+#pragma mark - Accessors
+
+- (NSUInteger)totalCostLimit
+{
+    return self.images.totalCostLimit;
+}
+
+- (void)setTotalCostLimit:(NSUInteger)totalCostLimit
+{
+    self.images.totalCostLimit = totalCostLimit;
+}
+
+
+#pragma mark - Prefetching
+
+- (void)prefetchAssets:(NSArray *)assets
+{
+    NSMutableArray *pendingAssets = [NSMutableArray new];
+    
+    for (id<KITAssetDataSource> asset in assets)
+    {
+        if ([self.images objectForKey:asset] || [self.loadingAssets containsObject:asset])
+            continue;
+        
+        // tiled pages need the encoded data, which is not worth holding for a page that may not be shown
+        CGSize pixelSize = CGSizeMake(asset.pixelWidth, asset.pixelHeight);
+        
+        if ([KITAssetTiledImageView shouldTileImageWithPixelSize:pixelSize])
+            continue;
+        
+        [pendingAssets addObject:asset];
+    }
+    
+    self.pendingAssets = pendingAssets;
+    
+    // going the other way makes the loads ahead useless
+    for (id<KITAssetDataSource> asset in self.loadingAssets.allObjects)
+    {
+        if (![assets containsObject:asset])
+            [self cancelLoadingAsset:asset];
+    }
+    
+    [self loadPendingAssets];
+}
+
+- (void)stopPrefetching
+{
+    [self.pendingAssets removeAllObjects];
+    
+    for (id<KITAssetDataSource> asset in self.loadingAssets.allObjects)
+        [self cancelLoadingAsset:asset];
+}
+
+- (void)cancelLoadingAsset:(id<KITAssetDataSource>)asset
+{
+    // a page is showing it
+    if ([self.waitingHandlers objectForKey:asset])
+        return;
+    
+    [self.loadingAssets removeObject:asset];
+    
+    if ([asset respondsToSelector:@selector(cancelAnyLoadingOfData)])
+        [asset cancelAnyLoadingOfData];
+}
+
+- (void)loadPendingAssets
+{
+    while (self.pendingAssets.count > 0 && self.loadingAssets.count < KITAssetImagePrefetcherMaximumConcurrentLoads)
+    {
+        id<KITAssetDataSource> asset = self.pendingAssets.firstObject;
+        [self.pendingAssets removeObjectAtIndex:0];
+        
+        [self loadAsset:asset];
+    }
+}
+
+- (void)loadAsset:(id<KITAssetDataSource>)asset
+{
+    [self.loadingAssets addObject:asset];
+    
+    CGFloat maximumPixelSize = self.maximumPixelSize;
+    __weak KITAssetImagePrefetcher *weakSelf = self;
+    
+    [asset dataWithCompletionHandler:^(NSData *data, NSError *error) {
+        // below the decodes of the page being shown
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+            UIImage *image = (data) ? [UIImage KITAssetsPickerImageWithData:data maximumPixelSize:maximumPixelSize] : nil;
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [weakSelf didLoadImage:image forAsset:asset];
+            });
+        });
+    }];
+}
+
+- (void)didLoadImage:(UIImage *)image forAsset:(id<KITAssetDataSource>)asset
+{
+    // cancelled on the way
+    if (![self.loadingAssets containsObject:asset])
+        return;
+    
+    [self.loadingAssets removeObject:asset];
+    
+    if (image)
+    {
+        CGImageRef imageRef = image.CGImage;
+        [self.images setObject:image forKey:asset cost:CGImageGetBytesPerRow(imageRef) * CGImageGetHeight(imageRef)];
+    }
+    
+    NSArray *handlers = [self.waitingHandlers objectForKey:asset];
+    [self.waitingHandlers removeObjectForKey:asset];
+    
+    for (void (^handler)(UIImage *) in handlers)
+        handler(image);
+    
+    [self loadPendingAssets];
+}
+
+
+#pragma mark - Looking up
+
+- (BOOL)imageForAsset:(id<KITAssetDataSource>)asset completionHandler:(void (^)(UIImage *))handler
+{
+    UIImage *image = [self.images objectForKey:asset];
+    
+    if (image)
+    {
+        handler(image);
+        return YES;
+    }
+    
+    if (![self.loadingAssets containsObject:asset])
+        return NO;
+    
+    NSArray *handlers = [self.waitingHandlers objectForKey:asset] ?: @[];
+    [self.waitingHandlers setObject:[handlers arrayByAddingObject:[handler copy]] forKey:asset];
+    
+    return YES;
+}
+
+@end
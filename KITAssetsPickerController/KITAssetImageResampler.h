@@ -0,0 +1,65 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <Foundation/Foundation.h>
+
+
+
+typedef NS_ENUM(NSInteger, KITAssetImageResamplerFilter) {
+    /**
+     *  Area averaging. Every source pixel contributes to exactly one destination pixel in proportion to its coverage.
+     */
+    KITAssetImageResamplerFilterBox,
+    /**
+     *  Windowed sinc with three lobes. Sharper than box at the cost of roughly six times the taps per pixel.
+     */
+    KITAssetImageResamplerFilterLanczos3
+};
+
+
+/**
+ *  Resamples an 8-bit, 4-channel (e.g. premultiplied RGBA) bitmap to the destination size in a single pass.
+ *
+ *  The filter is separable: each source row is filtered horizontally exactly once and the vertical filter
+ *  is accumulated from a small ring of filtered rows, so memory use is bounded by the destination width.
+ *  Pixels are processed as 4-lane vectors with SSE2 or NEON where available, with a scalar fallback.
+ *
+ *  @param src             The first byte of the source bitmap.
+ *  @param srcWidth        The source width in pixels.
+ *  @param srcHeight       The source height in pixels.
+ *  @param srcBytesPerRow  The source row stride in bytes.
+ *  @param dst             The first byte of the destination bitmap.
+ *  @param dstWidth        The destination width in pixels.
+ *  @param dstHeight       The destination height in pixels.
+ *  @param dstBytesPerRow  The destination row stride in bytes.
+ *  @param filter          The resampling filter.
+ *
+ *  @return `YES` on success, `NO` if the sizes are empty or memory could not be allocated.
+ */
+BOOL KITAssetImageResample(const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcBytesPerRow,
+                           uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstBytesPerRow,
+                           KITAssetImageResamplerFilter filter);
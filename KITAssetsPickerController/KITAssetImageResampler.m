@@ -0,0 +1,406 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetImageResampler.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+
+
+#pragma mark - Vector primitives
+
+// One pixel (4 channels) per vector lane group.
+
+#if defined(__SSE2__)
+
+typedef __m128 KITResamplerVector;
+
+static inline KITResamplerVector KITResamplerVectorZero(void)
+{
+    return _mm_setzero_ps();
+}
+
+static inline KITResamplerVector KITResamplerVectorSplat(float value)
+{
+    return _mm_set1_ps(value);
+}
+
+static inline KITResamplerVector KITResamplerVectorLoad(const float *p)
+{
+    return _mm_loadu_ps(p);
+}
+
+static inline void KITResamplerVectorStore(float *p, KITResamplerVector v)
+{
+    _mm_storeu_ps(p, v);
+}
+
+static inline KITResamplerVector KITResamplerVectorMultiplyAdd(KITResamplerVector acc, KITResamplerVector a, KITResamplerVector b)
+{
+    return _mm_add_ps(acc, _mm_mul_ps(a, b));
+}
+
+static inline KITResamplerVector KITResamplerVectorLoadPixel(const uint8_t *p)
+{
+    uint32_t bits;
+    memcpy(&bits, p, sizeof(bits));
+    
+    __m128i zero = _mm_setzero_si128();
+    __m128i x = _mm_cvtsi32_si128((int)bits);
+    x = _mm_unpacklo_epi8(x, zero);
+    x = _mm_unpacklo_epi16(x, zero);
+    
+    return _mm_cvtepi32_ps(x);
+}
+
+static inline void KITResamplerVectorStorePixel(uint8_t *p, KITResamplerVector v)
+{
+    // rounds to nearest, the saturating packs clamp to [0, 255]
+    __m128i x = _mm_cvtps_epi32(v);
+    x = _mm_packs_epi32(x, x);
+    x = _mm_packus_epi16(x, x);
+    
+    uint32_t bits = (uint32_t)_mm_cvtsi128_si32(x);
+    memcpy(p, &bits, sizeof(bits));
+}
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+typedef float32x4_t KITResamplerVector;
+
+static inline KITResamplerVector KITResamplerVectorZero(void)
+{
+    return vdupq_n_f32(0);
+}
+
+static inline KITResamplerVector KITResamplerVectorSplat(float value)
+{
+    return vdupq_n_f32(value);
+}
+
+static inline KITResamplerVector KITResamplerVectorLoad(const float *p)
+{
+    return vld1q_f32(p);
+}
+
+static inline void KITResamplerVectorStore(float *p, KITResamplerVector v)
+{
+    vst1q_f32(p, v);
+}
+
+static inline KITResamplerVector KITResamplerVectorMultiplyAdd(KITResamplerVector acc, KITResamplerVector a, KITResamplerVector b)
+{
+    return vmlaq_f32(acc, a, b);
+}
+
+static inline KITResamplerVector KITResamplerVectorLoadPixel(const uint8_t *p)
+{
+    uint32_t bits;
+    memcpy(&bits, p, sizeof(bits));
+    
+    uint8x8_t b = vreinterpret_u8_u32(vdup_n_u32(bits));
+    uint16x8_t h = vmovl_u8(b);
+    uint32x4_t w = vmovl_u16(vget_low_u16(h));
+    
+    return vcvtq_f32_u32(w);
+}
+
+static inline void KITResamplerVectorStorePixel(uint8_t *p, KITResamplerVector v)
+{
+    // vcvtq truncates, so clamp below and bias by half before converting; the narrowing moves saturate above
+    v = vmaxq_f32(v, vdupq_n_f32(0));
+    v = vaddq_f32(v, vdupq_n_f32(0.5f));
+    
+    uint16x4_t h = vqmovn_u32(vcvtq_u32_f32(v));
+    uint8x8_t b = vqmovn_u16(vcombine_u16(h, h));
+    
+    uint32_t bits = vget_lane_u32(vreinterpret_u32_u8(b), 0);
+    memcpy(p, &bits, sizeof(bits));
+}
+
+#else
+
+typedef struct { float v[4]; } KITResamplerVector;
+
+static inline KITResamplerVector KITResamplerVectorZero(void)
+{
+    KITResamplerVector r = {{0, 0, 0, 0}};
+    return r;
+}
+
+static inline KITResamplerVector KITResamplerVectorSplat(float value)
+{
+    KITResamplerVector r = {{value, value, value, value}};
+    return r;
+}
+
+static inline KITResamplerVector KITResamplerVectorLoad(const float *p)
+{
+    KITResamplerVector r;
+    memcpy(r.v, p, sizeof(r.v));
+    return r;
+}
+
+static inline void KITResamplerVectorStore(float *p, KITResamplerVector v)
+{
+    memcpy(p, v.v, sizeof(v.v));
+}
+
+static inline KITResamplerVector KITResamplerVectorMultiplyAdd(KITResamplerVector acc, KITResamplerVector a, KITResamplerVector b)
+{
+    for (int i = 0; i < 4; i++)
+        acc.v[i] += a.v[i] * b.v[i];
+    
+    return acc;
+}
+
+static inline KITResamplerVector KITResamplerVectorLoadPixel(const uint8_t *p)
+{
+    KITResamplerVector r = {{p[0], p[1], p[2], p[3]}};
+    return r;
+}
+
+static inline void KITResamplerVectorStorePixel(uint8_t *p, KITResamplerVector v)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        float value = v.v[i];
+        value = (value < 0) ? 0 : (value > 255) ? 255 : value;
+        p[i] = (uint8_t)(value + 0.5f);
+    }
+}
+
+#endif
+
+
+
+#pragma mark - Filter coefficients
+
+typedef struct {
+    size_t *start;      // first source index per destination index
+    size_t *count;      // number of taps per destination index
+    float *weights;     // `stride` normalised weights per destination index
+    size_t stride;      // the largest `count`
+} KITResamplerCoefficients;
+
+static double KITResamplerSinc(double x)
+{
+    if (x == 0)
+        return 1;
+    
+    x *= M_PI;
+    return sin(x) / x;
+}
+
+static double KITResamplerLanczos3(double x)
+{
+    if (x <= -3 || x >= 3)
+        return 0;
+    
+    return KITResamplerSinc(x) * KITResamplerSinc(x / 3);
+}
+
+static void KITResamplerCoefficientsFree(KITResamplerCoefficients *c)
+{
+    free(c->start);
+    free(c->count);
+    free(c->weights);
+    memset(c, 0, sizeof(*c));
+}
+
+static BOOL KITResamplerCoefficientsMake(KITResamplerCoefficients *c, size_t inSize, size_t outSize, KITAssetImageResamplerFilter filter)
+{
+    double scale        = (double)inSize / (double)outSize;
+    double filterScale  = MAX(scale, 1.0);
+    double support      = (filter == KITAssetImageResamplerFilterLanczos3) ? 3.0 * filterScale : 0.5 * filterScale;
+    
+    memset(c, 0, sizeof(*c));
+    c->stride   = (size_t)ceil(support) * 2 + 2;
+    c->start    = calloc(outSize, sizeof(size_t));
+    c->count    = calloc(outSize, sizeof(size_t));
+    c->weights  = calloc(outSize * c->stride, sizeof(float));
+    
+    if (!c->start || !c->count || !c->weights)
+    {
+        KITResamplerCoefficientsFree(c);
+        return NO;
+    }
+    
+    for (size_t out = 0; out < outSize; out++)
+    {
+        double center   = (out + 0.5) * scale;
+        double lower    = MAX(0.0, floor(center - support));
+        double upper    = MIN((double)inSize, ceil(center + support));
+        
+        size_t start    = (size_t)lower;
+        size_t count    = MIN((size_t)upper - start, c->stride);
+        float *weights  = c->weights + out * c->stride;
+        double total    = 0;
+        
+        for (size_t i = 0; i < count; i++)
+        {
+            double x = start + i;
+            double w;
+            
+            if (filter == KITAssetImageResamplerFilterLanczos3)
+            {
+                w = KITResamplerLanczos3((x + 0.5 - center) / filterScale);
+            }
+            else
+            {
+                // coverage of source pixel [x, x + 1] by the destination footprint
+                double from = center - support;
+                double to   = center + support;
+                w = MAX(0.0, MIN(x + 1, to) - MAX(x, from));
+            }
+            
+            weights[i] = (float)w;
+            total += w;
+        }
+        
+        // trim zero taps at both ends so the inner loops stay tight
+        while (count > 1 && weights[count - 1] == 0)
+            count--;
+        
+        while (count > 1 && weights[0] == 0)
+        {
+            memmove(weights, weights + 1, (count - 1) * sizeof(float));
+            start++;
+            count--;
+        }
+        
+        if (total != 0)
+            for (size_t i = 0; i < count; i++)
+                weights[i] = (float)(weights[i] / total);
+        
+        c->start[out] = start;
+        c->count[out] = count;
+    }
+    
+    return YES;
+}
+
+
+
+#pragma mark - Resample
+
+static void KITResamplerFilterRow(const uint8_t *src, float *row, size_t width, const KITResamplerCoefficients *c)
+{
+    for (size_t x = 0; x < width; x++)
+    {
+        const uint8_t *pixel    = src + c->start[x] * 4;
+        const float *weights    = c->weights + x * c->stride;
+        size_t count            = c->count[x];
+        
+        KITResamplerVector acc = KITResamplerVectorZero();
+        
+        for (size_t i = 0; i < count; i++)
+            acc = KITResamplerVectorMultiplyAdd(acc, KITResamplerVectorLoadPixel(pixel + i * 4), KITResamplerVectorSplat(weights[i]));
+        
+        KITResamplerVectorStore(row + x * 4, acc);
+    }
+}
+
+BOOL KITAssetImageResample(const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcBytesPerRow,
+                           uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstBytesPerRow,
+                           KITAssetImageResamplerFilter filter)
+{
+    if (!src || !dst || srcWidth == 0 || srcHeight == 0 || dstWidth == 0 || dstHeight == 0)
+        return NO;
+    
+    KITResamplerCoefficients horizontal, vertical;
+    
+    if (!KITResamplerCoefficientsMake(&horizontal, srcWidth, dstWidth, filter))
+        return NO;
+    
+    if (!KITResamplerCoefficientsMake(&vertical, srcHeight, dstHeight, filter))
+    {
+        KITResamplerCoefficientsFree(&horizontal);
+        return NO;
+    }
+    
+    // ring of horizontally filtered source rows, large enough for one destination row's vertical taps
+    size_t slots        = vertical.stride;
+    size_t rowLength    = dstWidth * 4;
+    float *ring         = malloc(slots * rowLength * sizeof(float));
+    size_t *ringRows    = malloc(slots * sizeof(size_t));
+    BOOL success        = (ring && ringRows);
+    
+    if (success)
+    {
+        for (size_t slot = 0; slot < slots; slot++)
+            ringRows[slot] = SIZE_MAX;
+        
+        for (size_t y = 0; y < dstHeight; y++)
+        {
+            size_t start            = vertical.start[y];
+            size_t count            = vertical.count[y];
+            const float *weights    = vertical.weights + y * vertical.stride;
+            uint8_t *out            = dst + y * dstBytesPerRow;
+            
+            // source rows only move forward, so each one is filtered horizontally at most once
+            for (size_t i = 0; i < count; i++)
+            {
+                size_t sy   = start + i;
+                size_t slot = sy % slots;
+                
+                if (ringRows[slot] != sy)
+                {
+                    KITResamplerFilterRow(src + sy * srcBytesPerRow, ring + slot * rowLength, dstWidth, &horizontal);
+                    ringRows[slot] = sy;
+                }
+            }
+            
+            for (size_t x = 0; x < dstWidth; x++)
+            {
+                KITResamplerVector acc = KITResamplerVectorZero();
+                
+                for (size_t i = 0; i < count; i++)
+                {
+                    const float *row = ring + ((start + i) % slots) * rowLength;
+                    acc = KITResamplerVectorMultiplyAdd(acc, KITResamplerVectorLoad(row + x * 4), KITResamplerVectorSplat(weights[i]));
+                }
+                
+                KITResamplerVectorStorePixel(out + x * 4, acc);
+            }
+        }
+    }
+    
+    free(ring);
+    free(ringRows);
+    KITResamplerCoefficientsFree(&horizontal);
+    KITResamplerCoefficientsFree(&vertical);
+    
+    return success;
+}
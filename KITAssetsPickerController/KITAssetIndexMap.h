@@ -0,0 +1,68 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "KITAssetCollectionDataSource.h"
+
+
+
+/**
+ *  Maps assets to their index in a collection, replacing linear `indexOfObject:` scans.
+ *
+ *  The map is built the first time it is asked, on the main thread in batches with the run loop turning in
+ *  between, so the collection is never read off the main thread. Until it is ready, lookups fall back to
+ *  `indexOfObject:` of the collection. Call `invalidate` whenever the collection changes. Assets are matched
+ *  with `isEqual:` and `hash`, as `indexOfObject:` does.
+ */
+@interface KITAssetIndexMap : NSObject
+
+/**
+ *  A map of an asset collection. `KITAsyncAssetCollectionDataSource` collections are always looked up directly.
+ */
+- (instancetype)initWithAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection;
+
+/**
+ *  A map of an array of assets.
+ */
+- (instancetype)initWithAssets:(NSArray *)assets;
+
+/**
+ *  The index of an asset, or `NSNotFound`. Called on the main thread.
+ */
+- (NSUInteger)indexOfAsset:(id)asset;
+
+/**
+ *  Whether the map has been built. Until then, lookups answer from the collection as it is now.
+ */
+@property (nonatomic, assign, readonly, getter=isBuilt) BOOL built;
+
+/**
+ *  Drops the map; it is rebuilt on the next lookup.
+ */
+- (void)invalidate;
+
+@end
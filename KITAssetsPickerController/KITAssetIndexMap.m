@@ -0,0 +1,172 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetIndexMap.h"
+#import "KITAsyncAssetCollectionDataSource.h"
+
+
+
+
+// collections are read in windows of this size while the map is built
+static const NSUInteger KITAssetIndexMapBatchSize = 1024;
+
+
+
+@interface KITAssetIndexMap ()
+
+@property (nonatomic, strong) id<KITAssetCollectionDataSource> assetCollection;
+@property (nonatomic, copy) NSArray *assets;
+
+@property (nonatomic, strong) NSMapTable *indexes;
+@property (nonatomic, assign) NSUInteger generation;
+@property (nonatomic, assign, getter=isBuilding) BOOL building;
+
+@end
+
+
+
+
+
+@implementation KITAssetIndexMap
+
+- (instancetype)initWithAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+{
+    if (self = [super init])
+    {
+        _assetCollection = assetCollection;
+    }
+    
+    return self;
+}
+
+- (instancetype)initWithAssets:(NSArray *)assets
+{
+    if (self = [super init])
+    {
+        _assets = [assets copy];
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Lookup
+
+- (NSUInteger)indexOfAsset:(id)asset
+{
+    if (!asset)
+        return NSNotFound;
+    
+    if (self.indexes)
+    {
+        NSNumber *index = [self.indexes objectForKey:asset];
+        return (index) ? index.unsignedIntegerValue : NSNotFound;
+    }
+    
+    [self buildIfNeeded];
+    
+    return (self.assets) ? [self.assets indexOfObject:asset] : [self.assetCollection indexOfObject:asset];
+}
+
+- (BOOL)isBuilt
+{
+    return (self.indexes != nil);
+}
+
+- (void)invalidate
+{
+    self.indexes = nil;
+    self.building = NO;
+    self.generation++;
+}
+
+
+#pragma mark - Build
+
+- (void)buildIfNeeded
+{
+    if (self.isBuilding)
+        return;
+    
+    // paged collections are looked up directly
+    if ([self.assetCollection conformsToProtocol:@protocol(KITAsyncAssetCollectionDataSource)])
+        return;
+    
+    self.building = YES;
+    
+    NSMapTable *indexes = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPersonality
+                                                valueOptions:NSPointerFunctionsStrongMemory];
+    
+    NSUInteger count = (self.assets) ? self.assets.count : self.assetCollection.count;
+    
+    [self addAssetsToIndexes:indexes fromIndex:0 count:count generation:self.generation];
+}
+
+// Assets are only read on the main thread, one batch per run loop turn so scrolling stays smooth
+- (void)addAssetsToIndexes:(NSMapTable *)indexes fromIndex:(NSUInteger)index count:(NSUInteger)count generation:(NSUInteger)generation
+{
+    // invalidated while building; the next lookup starts again
+    if (generation != self.generation)
+        return;
+    
+    // a collection that changed without telling is not mapped half old, half new
+    if (!self.assets && self.assetCollection.count != count)
+    {
+        self.building = NO;
+        return;
+    }
+    
+    if (index >= count)
+    {
+        self.indexes = indexes;
+        self.building = NO;
+        return;
+    }
+    
+    NSRange range = NSMakeRange(index, MIN(KITAssetIndexMapBatchSize, count - index));
+    
+    void (^addAsset)(id, NSUInteger, BOOL *) = ^(id obj, NSUInteger idx, BOOL *stop) {
+        // the first occurrence wins, as with indexOfObject:
+        if (![indexes objectForKey:obj])
+            [indexes setObject:@(idx) forKey:obj];
+    };
+    
+    @autoreleasepool {
+        if (self.assets)
+            [self.assets enumerateObjectsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:range] options:0 usingBlock:addAsset];
+        else
+            KITAssetCollectionEnumerateObjectsInRange(self.assetCollection, range, addAsset);
+    }
+    
+    __weak KITAssetIndexMap *weakSelf = self;
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf addAssetsToIndexes:indexes fromIndex:NSMaxRange(range) count:count generation:generation];
+    });
+}
+
+@end
@@ -26,6 +26,9 @@
 
 #import <UIKit/UIKit.h>
 #import "KITAssetDataSource.h"
+#import "KITAssetCollectionDataSource.h"
+
+@class KITAssetImagePrefetcher;
 
 
 @interface KITAssetItemViewController : UIViewController
@@ -34,6 +37,24 @@
 @property (nonatomic, strong, readonly) id<KITAssetDataSource> asset;
 @property (nonatomic, strong, readonly) UIImage *image;
 
+/**
+ *  The collection the asset was shown from and its index there, used to look up cached per-collection state.
+ *  The index is `NSNotFound` when unknown.
+ */
+@property (nonatomic, weak) id<KITAssetCollectionDataSource> assetCollection;
+@property (nonatomic, assign) NSUInteger assetIndex;
+
+/**
+ *  Where to look for an image decoded before the page was shown.
+ */
+@property (nonatomic, weak) KITAssetImagePrefetcher *prefetcher;
+
 + (KITAssetItemViewController *)assetItemViewControllerForAsset:(id<KITAssetDataSource> )asset;
 
+/**
+ *  Rebinds the controller to another asset, keeping its views. The image is requested when the page next appears,
+ *  and results still coming for the previous asset are dropped.
+ */
+- (void)prepareForReuseWithAsset:(id<KITAssetDataSource>)asset;
+
 @end
\ No newline at end of file
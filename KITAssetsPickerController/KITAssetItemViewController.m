@@ -27,9 +27,15 @@
 
 #import <PureLayout/PureLayout.h>
 #import "KITAssetsPickerController.h"
+#import "KITAssetsPickerController+Internal.h"
 #import "KITAssetItemViewController.h"
 #import "KITAssetScrollView.h"
 #import "NSBundle+KITAssetsPickerController.h"
+#import "KITAssetTiledImageView.h"
+#import "KITAssetProgressiveImageDecoder.h"
+#import "KITAssetDataReader.h"
+#import "KITAssetImagePrefetcher.h"
+#import "UIImage+KITAssetsPickerController.h"
 
 
 
@@ -39,6 +45,9 @@
 
 @property (nonatomic, strong) id<KITAssetDataSource> asset;
 @property (nonatomic, strong) UIImage *image;
+@property (nonatomic, strong) NSData *imageData;
+@property (nonatomic, assign) CGFloat requestedImagePixelSize;
+@property (nonatomic, strong) dispatch_queue_t decodeQueue;
 
 @property (nonatomic, strong) KITAssetScrollView *scrollView;
 
@@ -62,6 +71,8 @@
     if (self = [super init])
     {
         self.asset = asset;
+        self.assetIndex = NSNotFound;
+        self.decodeQueue = dispatch_queue_create("ly.kite.KITAssetsPickerController.decode", DISPATCH_QUEUE_SERIAL);
         self.allowsSelection = NO;
     }
     
@@ -69,10 +80,30 @@
 }
 
 
+- (void)prepareForReuseWithAsset:(id<KITAssetDataSource>)asset
+{
+    self.asset                      = asset;
+    self.image                      = nil;
+    self.imageData                  = nil;
+    self.requestedImagePixelSize    = 0;
+    self.assetIndex                 = NSNotFound;
+    
+    // the views are kept; only what was bound to the previous asset goes
+    if (self.isViewLoaded)
+        [self.scrollView prepareForReuse];
+}
+
+
 - (void)viewDidLoad
 {
     [super viewDidLoad];
     [self setupViews];
+    [self addNotificationObserver];
+}
+
+- (void)dealloc
+{
+    [self removeNotificationObserver];
 }
 
 - (void)viewWillAppear:(BOOL)animated
@@ -87,6 +118,14 @@
     [super viewWillDisappear:animated];
 }
 
+- (void)viewDidDisappear:(BOOL)animated
+{
+    [super viewDidDisappear:animated];
+    
+    // only kept for zooming in on the visible page
+    self.imageData = nil;
+}
+
 - (void)viewWillLayoutSubviews
 {
     [super viewWillLayoutSubviews];
@@ -141,16 +180,186 @@
 
 - (void)requestAssetImage
 {
+    if (self.image || self.requestedImagePixelSize > 0)
+        return;
+    
     [self.scrollView setProgress:0];
     
-    [self.asset dataWithCompletionHandler:^(NSData *data, NSError *error){
-        self.image = [UIImage imageWithData:data];
-        dispatch_async(dispatch_get_main_queue(), ^{
+    CGSize targetSize = [self targetImageSize];
+    CGFloat maximumPixelSize = MAX(targetSize.width, targetSize.height);
+    KITAssetImagePrefetcher *prefetcher = self.prefetcher;
+    
+    if (prefetcher.maximumPixelSize >= maximumPixelSize)
+    {
+        self.requestedImagePixelSize = maximumPixelSize;
+        
+        id<KITAssetDataSource> asset = self.asset;
+        
+        BOOL isPrefetched = [prefetcher imageForAsset:asset completionHandler:^(UIImage *image) {
+            // rebound to another asset while waiting
+            if (self.asset != asset)
+                return;
+            
+            if (image)
+                [self bindPrefetchedImage:image];
+            else
+                [self loadAssetImageWithMaximumPixelSize:maximumPixelSize];
+        }];
+        
+        if (isPrefetched)
+            return;
+    }
+    
+    [self loadAssetImageWithMaximumPixelSize:maximumPixelSize];
+}
+
+- (void)bindPrefetchedImage:(UIImage *)image
+{
+    self.image = image;
+    
+    [self.scrollView bind:self.asset image:image requestInfo:@{}];
+    [self.scrollView setProgress:1];
+}
+
+- (void)loadAssetImageWithMaximumPixelSize:(CGFloat)maximumPixelSize
+{
+    // decoded straight to screen size; a full-size bitmap of a large photo runs to hundreds of megabytes
+    [self requestAssetImageWithMaximumPixelSize:maximumPixelSize previewHandler:^(UIImage *preview, CGFloat progress) {
+        [self bindPreview:preview progress:progress];
+    } completionHandler:^(UIImage *image, NSData *data) {
+        // a failed request is tried again when the page next appears
+        if (!image)
+            self.requestedImagePixelSize = 0;
+        
+        self.image = image;
+        self.imageData = (image) ? data : nil;
+        
+        if (self.scrollView.image && image)
+            [self.scrollView updateImage:image];
+        else
             [self.scrollView bind:self.asset image:self.image requestInfo:@{}];
+        
+        [self.scrollView setProgress:1];
+        
+        CGSize pixelSize = CGSizeMake(self.asset.pixelWidth, self.asset.pixelHeight);
+        
+        if (image && [KITAssetTiledImageView shouldTileImageWithPixelSize:pixelSize])
+            [self.scrollView bindTiledImageData:data];
+    }];
+}
+
+- (void)requestAssetImageWithMaximumPixelSize:(CGFloat)maximumPixelSize
+                               previewHandler:(void (^)(UIImage *preview, CGFloat progress))previewHandler
+                            completionHandler:(void (^)(UIImage *image, NSData *data))handler
+{
+    self.requestedImagePixelSize = maximumPixelSize;
+    
+    id<KITAssetDataSource> asset = self.asset;
+    dispatch_queue_t decodeQueue = self.decodeQueue;
+    
+    void (^completionHandler)(NSData *, NSError *) = ^(NSData *data, NSError *error) {
+        [self decodeImageData:data ofAsset:asset maximumPixelSize:maximumPixelSize completionHandler:handler];
+    };
+    
+    if (![KITAssetDataReader assetSupportsChunkedReading:asset])
+    {
+        [asset dataWithCompletionHandler:completionHandler];
+        return;
+    }
+    
+    KITAssetDataReader *reader = [[KITAssetDataReader alloc] initWithAsset:asset];
+    KITAssetProgressiveImageDecoder *decoder = [[KITAssetProgressiveImageDecoder alloc] initWithMaximumPixelSize:maximumPixelSize];
+    
+    [reader readWithChunkHandler:^(NSData *chunk, long long offset, long long expectedLength) {
+        dispatch_async(decodeQueue, ^{
+            UIImage *preview = [decoder previewByAppendingData:chunk expectedLength:expectedLength];
+            CGFloat progress = (expectedLength > 0) ? MIN((CGFloat)decoder.receivedLength / expectedLength, 1) : 0;
+            
+            if (previewHandler)
+            {
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    if (self.asset == asset)
+                        previewHandler(preview, progress);
+                });
+            }
+        });
+    } completionHandler:^(NSError *error) {
+        // the decoder has every chunk by the time this runs on the decode queue
+        dispatch_async(decodeQueue, ^{
+            completionHandler((error) ? nil : decoder.receivedData, error);
         });
     }];
 }
 
+- (void)decodeImageData:(NSData *)data
+                ofAsset:(id<KITAssetDataSource>)asset
+       maximumPixelSize:(CGFloat)maximumPixelSize
+      completionHandler:(void (^)(UIImage *image, NSData *data))handler
+{
+    // queued behind any preview still decoding
+    dispatch_async(self.decodeQueue, ^{
+        UIImage *image = [UIImage KITAssetsPickerImageWithData:data maximumPixelSize:maximumPixelSize];
+        
+        // results for an asset the controller was rebound from are dropped
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (self.asset == asset)
+                handler(image, data);
+        });
+    });
+}
+
+- (void)bindPreview:(UIImage *)preview progress:(CGFloat)progress
+{
+    if (self.image)
+        return;
+    
+    if (preview && !self.scrollView.image)
+        [self.scrollView bind:self.asset image:preview requestInfo:@{}];
+    else if (preview)
+        [self.scrollView updateImage:preview];
+    
+    // binding finishes the progress bar, which keeps going until the whole image is in
+    [self.scrollView setProgress:MIN(progress, 0.99)];
+}
+
+// zooming past the screen-sized decode asks for a sharper one, up to the original size
+- (void)requestSharperAssetImageIfNeeded
+{
+    KITAssetScrollView *scrollView = self.scrollView;
+    
+    if (!self.image || scrollView.isTiled || scrollView.minimumZoomScale <= 0)
+        return;
+    
+    CGSize targetSize       = [self targetImageSize];
+    CGFloat assetPixelSize  = MAX(self.asset.pixelWidth, self.asset.pixelHeight);
+    CGFloat zoom            = scrollView.zoomScale / scrollView.minimumZoomScale;
+    CGFloat pixelSize       = MIN(MAX(targetSize.width, targetSize.height) * zoom, assetPixelSize);
+    
+    // small steps are not worth another decode
+    if (pixelSize < self.requestedImagePixelSize * 1.25)
+        return;
+    
+    void (^completionHandler)(UIImage *, NSData *) = ^(UIImage *image, NSData *data) {
+        if (!image)
+            return;
+        
+        self.image = image;
+        self.imageData = (self.isViewLoaded && self.view.window) ? data : nil;
+        [self.scrollView updateImage:image];
+    };
+    
+    // the page keeps the encoded data while visible, so only the first step reads the asset
+    if (self.imageData)
+    {
+        self.requestedImagePixelSize = pixelSize;
+        [self decodeImageData:self.imageData ofAsset:self.asset maximumPixelSize:pixelSize completionHandler:completionHandler];
+    }
+    else
+    {
+        [self requestAssetImageWithMaximumPixelSize:pixelSize previewHandler:nil completionHandler:completionHandler];
+    }
+}
+
 - (CGSize)targetImageSize
 {
     UIScreen *screen    = UIScreen.mainScreen;
@@ -159,6 +368,27 @@
 }
 
 
+#pragma mark - Notifications
+
+- (void)addNotificationObserver
+{
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(assetScrollViewDidEndZooming:)
+                                                 name:KITAssetScrollViewDidEndZoomingNotification
+                                               object:self.scrollView];
+}
+
+- (void)removeNotificationObserver
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self name:KITAssetScrollViewDidEndZoomingNotification object:nil];
+}
+
+- (void)assetScrollViewDidEndZooming:(NSNotification *)notification
+{
+    [self requestSharperAssetImageIfNeeded];
+}
+
+
 #pragma mark - Request error
 
 - (void)showRequestImageError:(NSError *)error title:(NSString *)title
@@ -231,10 +461,7 @@
 
 - (BOOL)assetScrollView:(KITAssetScrollView *)scrollView shouldEnableAsset:(id<KITAssetDataSource> )asset
 {
-    if ([self.picker.delegate respondsToSelector:@selector(assetsPickerController:shouldEnableAsset:)])
-        return [self.picker.delegate assetsPickerController:self.picker shouldEnableAsset:asset];
-    else
-        return YES;
+    return [self.picker shouldEnableAsset:asset atIndex:self.assetIndex inAssetCollection:self.assetCollection];
 }
 
 - (BOOL)assetScrollView:(KITAssetScrollView *)scrollView shouldSelectAsset:(id<KITAssetDataSource> )asset
@@ -0,0 +1,80 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+
+
+/**
+ *  The image formats the picker tells apart.
+ */
+typedef NS_ENUM(uint8_t, KITAssetMimeType) {
+    KITAssetMimeTypeUnknown = 0,
+    KITAssetMimeTypeJPEG,
+    KITAssetMimeTypePNG,
+    KITAssetMimeTypeHEIC,
+    KITAssetMimeTypeGIF,
+    KITAssetMimeTypeTIFF,
+    KITAssetMimeTypeOther
+};
+
+/**
+ *  A set of mime types, one bit per `KITAssetMimeType`. Assets whose mime type is not known are only in a set
+ *  that includes `KITAssetMimeTypeMaskUnknown`.
+ */
+typedef NS_OPTIONS(uint32_t, KITAssetMimeTypeMask) {
+    KITAssetMimeTypeMaskUnknown = 1 << KITAssetMimeTypeUnknown,
+    KITAssetMimeTypeMaskJPEG    = 1 << KITAssetMimeTypeJPEG,
+    KITAssetMimeTypeMaskPNG     = 1 << KITAssetMimeTypePNG,
+    KITAssetMimeTypeMaskHEIC    = 1 << KITAssetMimeTypeHEIC,
+    KITAssetMimeTypeMaskGIF     = 1 << KITAssetMimeTypeGIF,
+    KITAssetMimeTypeMaskTIFF    = 1 << KITAssetMimeTypeTIFF,
+    KITAssetMimeTypeMaskOther   = 1 << KITAssetMimeTypeOther,
+    KITAssetMimeTypeMaskAll     = 0xFFFFFFFF
+};
+
+/**
+ *  Columns of asset metadata, one row per asset, filled by `getMetadataColumns:inRange:`.
+ *
+ *  Unknown byte lengths are `-1` and unknown creation dates are `NAN`; dates are seconds since the reference date.
+ */
+typedef struct
+{
+    CGFloat *pixelWidths;
+    CGFloat *pixelHeights;
+    KITAssetMimeType *mimeTypes;
+    int64_t *byteLengths;
+    NSTimeInterval *creationDates;
+} KITAssetMetadataColumns;
+
+
+
+/**
+ *  The mime type for a string such as `@"image/jpeg"`.
+ */
+FOUNDATION_EXTERN KITAssetMimeType KITAssetMimeTypeFromString(NSString *mimeType);
@@ -0,0 +1,84 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "KITAssetMetadata.h"
+#import "KITAssetCollectionDataSource.h"
+
+
+
+/**
+ *  Asset metadata of a collection kept as columns (struct of arrays), so that filtering and sorting run as
+ *  tight loops over plain memory instead of one message per asset.
+ *
+ *  Collections implementing `getMetadataColumns:inRange:` fill the columns in bulk; others are read asset by
+ *  asset once, in which case byte lengths stay unknown. A store is immutable once built and can be read from
+ *  any thread.
+ */
+@interface KITAssetMetadataStore : NSObject
+
+/**
+ *  Builds a store and calls the handler on the main thread. Call it on the main thread.
+ *
+ *  The count and the loaded state of the collection are read at once. Bulk columns are then read on a background
+ *  queue; otherwise assets are read on the main thread in batches, between which the run loop keeps going.
+ *  A paged collection that is not fully loaded, or a collection that shrinks while being read, gives an empty store.
+ */
++ (void)buildMetadataStoreForAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+                           completionHandler:(void (^)(KITAssetMetadataStore *metadataStore))handler;
+
+/**
+ *  Whether the collection can fill the columns in bulk.
+ */
++ (BOOL)assetCollectionProvidesMetadataColumns:(id<KITAssetCollectionDataSource>)assetCollection;
+
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ *  The columns, each with `count` rows. Owned by the store.
+ */
+@property (nonatomic, assign, readonly) KITAssetMetadataColumns columns;
+
+/**
+ *  The indexes of assets at least `minimumPixelSize` in either orientation whose mime type is in `mimeTypes`.
+ *  Assets of unknown size pass; assets of unknown type pass only if `mimeTypes` includes `KITAssetMimeTypeMaskUnknown`.
+ */
+- (NSIndexSet *)indexesOfAssetsWithMinimumPixelSize:(CGSize)minimumPixelSize mimeTypes:(KITAssetMimeTypeMask)mimeTypes;
+
+/**
+ *  The same test as `indexesOfAssetsWithMinimumPixelSize:mimeTypes:`, writing `1` or `0` per asset into `flags`,
+ *  which has room for `count` entries.
+ */
+- (void)evaluateMinimumPixelSize:(CGSize)minimumPixelSize mimeTypes:(KITAssetMimeTypeMask)mimeTypes intoFlags:(uint8_t *)flags;
+
+/**
+ *  Fills `indexes`, which has room for `count` entries, with the asset indexes ordered by creation date.
+ *  The sort is stable and undated assets come last.
+ */
+- (void)getIndexes:(NSUInteger *)indexes sortedByCreationDateAscending:(BOOL)ascending;
+
+@end
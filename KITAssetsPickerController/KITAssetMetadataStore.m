@@ -0,0 +1,270 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetMetadataStore.h"
+#import "KITAssetDataSource.h"
+#import "KITAsyncAssetCollectionDataSource.h"
+
+
+
+
+// collections are read in windows of this size while the store is built
+static const NSUInteger KITAssetMetadataStoreBatchSize = 1024;
+
+
+
+@interface KITAssetMetadataStore ()
+
+@property (nonatomic, assign, readwrite) NSUInteger count;
+@property (nonatomic, assign, readwrite) KITAssetMetadataColumns columns;
+
+@end
+
+
+
+
+
+@implementation KITAssetMetadataStore
+
++ (void)buildMetadataStoreForAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+                           completionHandler:(void (^)(KITAssetMetadataStore *))handler
+{
+    // the count and the loaded state are read here on the main thread, as paged collections require
+    NSUInteger count = assetCollection.count;
+    
+    // paged collections only hold the pages loaded so far
+    if ([assetCollection conformsToProtocol:@protocol(KITAsyncAssetCollectionDataSource)] &&
+        ![(id<KITAsyncAssetCollectionDataSource>)assetCollection areObjectsLoadedInRange:NSMakeRange(0, count)])
+        count = 0;
+    
+    KITAssetMetadataStore *metadataStore = [[self alloc] initWithCount:count];
+    
+    if ([self assetCollectionProvidesMetadataColumns:assetCollection])
+    {
+        // bulk columns are documented as thread-safe
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+            [metadataStore readMetadataColumnsOfCollection:assetCollection];
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                handler(metadataStore);
+            });
+        });
+    }
+    else
+    {
+        [metadataStore readAssetsOfCollection:assetCollection fromIndex:0 completionHandler:handler];
+    }
+}
+
++ (BOOL)assetCollectionProvidesMetadataColumns:(id<KITAssetCollectionDataSource>)assetCollection
+{
+    return [assetCollection respondsToSelector:@selector(getMetadataColumns:inRange:)];
+}
+
+- (instancetype)initWithCount:(NSUInteger)count
+{
+    if (self = [super init])
+    {
+        NSUInteger rows = MAX(count, 1);
+        KITAssetMetadataColumns columns;
+        
+        columns.pixelWidths     = malloc(rows * sizeof(CGFloat));
+        columns.pixelHeights    = malloc(rows * sizeof(CGFloat));
+        columns.mimeTypes       = malloc(rows * sizeof(KITAssetMimeType));
+        columns.byteLengths     = malloc(rows * sizeof(int64_t));
+        columns.creationDates   = malloc(rows * sizeof(NSTimeInterval));
+        
+        _count      = count;
+        _columns    = columns;
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_columns.pixelWidths);
+    free(_columns.pixelHeights);
+    free(_columns.mimeTypes);
+    free(_columns.byteLengths);
+    free(_columns.creationDates);
+}
+
+
+#pragma mark - Reading
+
+- (void)readMetadataColumnsOfCollection:(id<KITAssetCollectionDataSource>)assetCollection
+{
+    for (NSUInteger location = 0; location < self.count; location += KITAssetMetadataStoreBatchSize)
+    {
+        NSRange range = NSMakeRange(location, MIN(KITAssetMetadataStoreBatchSize, self.count - location));
+        [assetCollection getMetadataColumns:[self columnsFromIndex:location] inRange:range];
+    }
+}
+
+// Asset objects are only read on the main thread, one batch per run loop turn so scrolling stays smooth
+- (void)readAssetsOfCollection:(id<KITAssetCollectionDataSource>)assetCollection
+                     fromIndex:(NSUInteger)index
+             completionHandler:(void (^)(KITAssetMetadataStore *))handler
+{
+    // a collection that changed while being read leaves an empty store, which callers treat as not built
+    if (assetCollection.count < self.count)
+        self.count = 0;
+    
+    if (index >= self.count)
+    {
+        handler(self);
+        return;
+    }
+    
+    NSRange range = NSMakeRange(index, MIN(KITAssetMetadataStoreBatchSize, self.count - index));
+    
+    @autoreleasepool {
+        [self readAssetsOfCollection:assetCollection inRange:range];
+    }
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self readAssetsOfCollection:assetCollection fromIndex:NSMaxRange(range) completionHandler:handler];
+    });
+}
+
+- (void)readAssetsOfCollection:(id<KITAssetCollectionDataSource>)assetCollection inRange:(NSRange)range
+{
+    KITAssetMetadataColumns columns = self.columns;
+    
+    KITAssetCollectionEnumerateObjectsInRange(assetCollection, range, ^(id<KITAssetDataSource> asset, NSUInteger idx, BOOL *stop) {
+        NSDate *date = ([asset respondsToSelector:@selector(creationDate)]) ? [asset creationDate] : nil;
+        
+        columns.pixelWidths[idx]    = asset.pixelWidth;
+        columns.pixelHeights[idx]   = asset.pixelHeight;
+        columns.mimeTypes[idx]      = KITAssetMimeTypeFromString(asset.mimeType);
+        columns.byteLengths[idx]    = -1;
+        columns.creationDates[idx]  = (date) ? date.timeIntervalSinceReferenceDate : NAN;
+    });
+}
+
+- (KITAssetMetadataColumns)columnsFromIndex:(NSUInteger)index
+{
+    KITAssetMetadataColumns columns = self.columns;
+    
+    columns.pixelWidths     += index;
+    columns.pixelHeights    += index;
+    columns.mimeTypes       += index;
+    columns.byteLengths     += index;
+    columns.creationDates   += index;
+    
+    return columns;
+}
+
+
+#pragma mark - Filtering
+
+- (NSIndexSet *)indexesOfAssetsWithMinimumPixelSize:(CGSize)minimumPixelSize mimeTypes:(KITAssetMimeTypeMask)mimeTypes
+{
+    NSUInteger count = self.count;
+    uint8_t *passes = malloc(MAX(count, 1));
+    
+    [self evaluateMinimumPixelSize:minimumPixelSize mimeTypes:mimeTypes intoFlags:passes];
+    
+    NSMutableIndexSet *indexes = [NSMutableIndexSet new];
+    NSUInteger start = NSNotFound;
+    
+    // runs of passing assets are added as ranges
+    for (NSUInteger index = 0; index <= count; index++)
+    {
+        BOOL pass = (index < count && passes[index]);
+        
+        if (pass && start == NSNotFound)
+            start = index;
+        else if (!pass && start != NSNotFound)
+        {
+            [indexes addIndexesInRange:NSMakeRange(start, index - start)];
+            start = NSNotFound;
+        }
+    }
+    
+    free(passes);
+    
+    return indexes;
+}
+
+// branch-free over plain columns so the compiler can vectorise it
+- (void)evaluateMinimumPixelSize:(CGSize)minimumPixelSize mimeTypes:(KITAssetMimeTypeMask)mimeTypes intoFlags:(uint8_t *)flags
+{
+    const CGFloat shortSide = MIN(minimumPixelSize.width, minimumPixelSize.height);
+    const CGFloat longSide  = MAX(minimumPixelSize.width, minimumPixelSize.height);
+    const uint32_t typeMask = mimeTypes;
+    
+    const CGFloat *widths           = self.columns.pixelWidths;
+    const CGFloat *heights          = self.columns.pixelHeights;
+    const KITAssetMimeType *types   = self.columns.mimeTypes;
+    const NSUInteger count          = self.count;
+    
+    for (NSUInteger index = 0; index < count; index++)
+    {
+        CGFloat width   = widths[index];
+        CGFloat height  = heights[index];
+        CGFloat minSide = (width < height) ? width : height;
+        CGFloat maxSide = (width < height) ? height : width;
+        
+        uint8_t unknownSize = (minSide <= 0);
+        uint8_t largeEnough = (minSide >= shortSide) & (maxSide >= longSide);
+        uint8_t allowedType = (typeMask >> types[index]) & 1;
+        
+        flags[index] = (unknownSize | largeEnough) & allowedType;
+    }
+}
+
+
+#pragma mark - Sorting
+
+- (void)getIndexes:(NSUInteger *)indexes sortedByCreationDateAscending:(BOOL)ascending
+{
+    const NSTimeInterval *dates = self.columns.creationDates;
+    const NSUInteger count = self.count;
+    
+    for (NSUInteger index = 0; index < count; index++)
+        indexes[index] = index;
+    
+    if (count < 2)
+        return;
+    
+    mergesort_b(indexes, count, sizeof(NSUInteger), ^int(const void *a, const void *b) {
+        NSTimeInterval dateA = dates[*(const NSUInteger *)a];
+        NSTimeInterval dateB = dates[*(const NSUInteger *)b];
+        
+        if (isnan(dateA) || isnan(dateB))
+            return (isnan(dateA) ? 1 : 0) - (isnan(dateB) ? 1 : 0);
+        
+        if (dateA == dateB)
+            return 0;
+        
+        return ((dateA < dateB) == ascending) ? -1 : 1;
+    });
+}
+
+@end
@@ -0,0 +1,88 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <UIKit/UIKit.h>
+
+
+
+typedef NS_OPTIONS(NSUInteger, KITAssetOverlayState) {
+    KITAssetOverlayStateNone            = 0,
+    KITAssetOverlayStateDisabled        = 1 << 0,
+    KITAssetOverlayStateHighlighted     = 1 << 1,
+    KITAssetOverlayStateSelected        = 1 << 2,
+    /**
+     *  Together with `KITAssetOverlayStateSelected`, shows the selection order instead of a checkmark.
+     */
+    KITAssetOverlayStateSelectionIndex  = 1 << 3
+};
+
+
+/**
+ *  Optional overlay attributes. Missing values fall back to the picker's default appearance,
+ *  resolved when the bitmap is rendered.
+ */
+extern NSString * const KITAssetOverlayDisabledColorAttributeName;
+extern NSString * const KITAssetOverlayHighlightedColorAttributeName;
+extern NSString * const KITAssetOverlaySelectedBackgroundColorAttributeName;
+extern NSString * const KITAssetOverlayFontAttributeName;
+extern NSString * const KITAssetOverlayTextColorAttributeName;
+
+
+/**
+ *  A process-wide cache of pre-rendered overlay bitmaps for grid cells.
+ *
+ *  Bitmaps are keyed by state, size, scale, tint colour, selection index and attributes, so every cell
+ *  showing the same state shares one image and changing a selection index is a single contents swap.
+ *  A new tint colour (including the dimmed tint while an alert is shown) resolves to a new key;
+ *  the whole cache is purged when the Dynamic Type size changes.
+ */
+@interface KITAssetOverlayImageCache : NSObject
+
++ (instancetype)sharedCache;
+
+/**
+ *  Returns the overlay bitmap for the state.
+ *
+ *  @param state          The overlay state.
+ *  @param size           The size of the cell in points, or `CGSizeZero` for the selection badge alone at its natural size.
+ *  @param scale          The scale of the bitmap.
+ *  @param tintColor      The tint colour of the checkmark, the selection index badge and the border.
+ *  @param selectionIndex The zero-based selection index, only used with `KITAssetOverlayStateSelectionIndex`.
+ *  @param attributes     Optional appearance attributes.
+ *
+ *  @return The bitmap, or `nil` if the state draws nothing.
+ */
+- (UIImage *)overlayImageForState:(KITAssetOverlayState)state
+                             size:(CGSize)size
+                            scale:(CGFloat)scale
+                        tintColor:(UIColor *)tintColor
+                   selectionIndex:(NSUInteger)selectionIndex
+                       attributes:(NSDictionary *)attributes;
+
+- (void)removeAllImages;
+
+@end
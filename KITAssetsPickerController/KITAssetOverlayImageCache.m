@@ -0,0 +1,320 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetsPickerDefines.h"
+#import "KITAssetOverlayImageCache.h"
+#import "UIImage+KITAssetsPickerController.h"
+
+
+
+
+NSString * const KITAssetOverlayDisabledColorAttributeName = @"KITAssetOverlayDisabledColorAttributeName";
+NSString * const KITAssetOverlayHighlightedColorAttributeName = @"KITAssetOverlayHighlightedColorAttributeName";
+NSString * const KITAssetOverlaySelectedBackgroundColorAttributeName = @"KITAssetOverlaySelectedBackgroundColorAttributeName";
+NSString * const KITAssetOverlayFontAttributeName = @"KITAssetOverlayFontAttributeName";
+NSString * const KITAssetOverlayTextColorAttributeName = @"KITAssetOverlayTextColorAttributeName";
+
+
+
+@interface KITAssetOverlayImageKey : NSObject
+
+@property (nonatomic, assign) KITAssetOverlayState state;
+@property (nonatomic, assign) CGSize size;
+@property (nonatomic, assign) CGFloat scale;
+@property (nonatomic, strong) UIColor *tintColor;
+@property (nonatomic, assign) NSUInteger selectionIndex;
+@property (nonatomic, copy) NSDictionary *attributes;
+
+@end
+
+
+
+@implementation KITAssetOverlayImageKey
+
+- (NSUInteger)hash
+{
+    return self.state ^ (self.selectionIndex << 4) ^ ((NSUInteger)(self.size.width * 31 + self.size.height) << 12) ^ self.tintColor.hash;
+}
+
+- (BOOL)isEqual:(id)object
+{
+    if (![object isKindOfClass:[KITAssetOverlayImageKey class]])
+        return NO;
+    
+    KITAssetOverlayImageKey *key = (KITAssetOverlayImageKey *)object;
+    
+    return (key.state == self.state &&
+            key.selectionIndex == self.selectionIndex &&
+            key.scale == self.scale &&
+            CGSizeEqualToSize(key.size, self.size) &&
+            (key.tintColor == self.tintColor || [key.tintColor isEqual:self.tintColor]) &&
+            (key.attributes == self.attributes || [key.attributes isEqualToDictionary:self.attributes]));
+}
+
+@end
+
+
+
+
+@interface KITAssetOverlayImageCache ()
+
+@property (nonatomic, strong) NSCache *cache;
+
+@end
+
+
+
+
+
+@implementation KITAssetOverlayImageCache
+
++ (instancetype)sharedCache
+{
+    static KITAssetOverlayImageCache *cache;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        cache = [self new];
+    });
+    
+    return cache;
+}
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        _cache = [NSCache new];
+        _cache.countLimit = 200;
+        
+        [self addNotificationObserver];
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    [self removeNotificationObserver];
+}
+
+
+#pragma mark - Notifications
+
+- (void)addNotificationObserver
+{
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(contentSizeCategoryChanged:)
+                                                 name:UIContentSizeCategoryDidChangeNotification
+                                               object:nil];
+}
+
+- (void)removeNotificationObserver
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self name:UIContentSizeCategoryDidChangeNotification object:nil];
+}
+
+- (void)contentSizeCategoryChanged:(NSNotification *)notification
+{
+    [self removeAllImages];
+}
+
+
+#pragma mark - Cache
+
+- (void)removeAllImages
+{
+    [self.cache removeAllObjects];
+}
+
+- (UIImage *)overlayImageForState:(KITAssetOverlayState)state
+                             size:(CGSize)size
+                            scale:(CGFloat)scale
+                        tintColor:(UIColor *)tintColor
+                   selectionIndex:(NSUInteger)selectionIndex
+                       attributes:(NSDictionary *)attributes
+{
+    if (!(state & KITAssetOverlayStateSelected))
+        state &= ~KITAssetOverlayStateSelectionIndex;
+    
+    if (state == KITAssetOverlayStateNone)
+        return nil;
+    
+    // every checkmark looks the same, only the selection order differs per index
+    if (!(state & KITAssetOverlayStateSelectionIndex))
+        selectionIndex = 0;
+    
+    KITAssetOverlayImageKey *key = [KITAssetOverlayImageKey new];
+    key.state           = state;
+    key.size            = size;
+    key.scale           = scale;
+    key.tintColor       = (tintColor) ? tintColor : KITAssetsGridSelectedViewTintColor;
+    key.selectionIndex  = selectionIndex;
+    key.attributes      = attributes;
+    
+    UIImage *image = [self.cache objectForKey:key];
+    
+    if (!image)
+    {
+        image = [self renderImageForKey:key];
+        
+        if (image)
+            [self.cache setObject:image forKey:key];
+    }
+    
+    return image;
+}
+
+
+#pragma mark - Render
+
+- (UIImage *)renderImageForKey:(KITAssetOverlayImageKey *)key
+{
+    KITAssetOverlayState state = key.state;
+    BOOL badgeOnly = CGSizeEqualToSize(key.size, CGSizeZero);
+    
+    CGSize size = (badgeOnly) ? [self badgeSizeForKey:key] : key.size;
+    
+    if (size.width <= 0 || size.height <= 0)
+        return nil;
+    
+    CGRect rect = CGRectMake(0, 0, size.width, size.height);
+    
+    UIGraphicsBeginImageContextWithOptions(size, NO, key.scale);
+    
+    // same stacking as the view based cell: disabled, highlighted, then selected on top
+    if (!badgeOnly && (state & KITAssetOverlayStateDisabled))
+    {
+        [[self attribute:KITAssetOverlayDisabledColorAttributeName ofKey:key fallback:KITAssetsGridViewCellDisabledColor] setFill];
+        UIRectFillUsingBlendMode(rect, kCGBlendModeNormal);
+        
+        UIImage *disabledImage = [UIImage KITAssetsPickerImageNamed:@"GridDisabledAsset"];
+        [self drawImage:disabledImage inRect:[self rect:rect centeringSize:disabledImage.size] tintColor:KITAssetsPikcerThumbnailTintColor];
+    }
+    
+    if (!badgeOnly && (state & KITAssetOverlayStateHighlighted))
+    {
+        [[self attribute:KITAssetOverlayHighlightedColorAttributeName ofKey:key fallback:KITAssetsGridViewCellHighlightedColor] setFill];
+        UIRectFillUsingBlendMode(rect, kCGBlendModeNormal);
+    }
+    
+    if (state & KITAssetOverlayStateSelected)
+    {
+        if (!badgeOnly)
+        {
+            [[self attribute:KITAssetOverlaySelectedBackgroundColorAttributeName ofKey:key fallback:KITAssetsGridSelectedViewBackgroundColor] setFill];
+            UIRectFillUsingBlendMode(rect, kCGBlendModeNormal);
+        }
+        
+        [self drawBadgeInRect:rect key:key];
+    }
+    
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    
+    return image;
+}
+
+- (CGSize)badgeSizeForKey:(KITAssetOverlayImageKey *)key
+{
+    if (!(key.state & KITAssetOverlayStateSelected))
+        return CGSizeZero;
+    
+    if (key.state & KITAssetOverlayStateSelectionIndex)
+    {
+        CGFloat length = [self fontOfKey:key].pointSize + 8;
+        return CGSizeMake(length, length);
+    }
+    
+    return [UIImage KITAssetsPickerImageNamed:@"CheckmarkShadow"].size;
+}
+
+- (void)drawBadgeInRect:(CGRect)rect key:(KITAssetOverlayImageKey *)key
+{
+    CGSize size = [self badgeSizeForKey:key];
+    
+    if (key.state & KITAssetOverlayStateSelectionIndex)
+    {
+        CGRect badge = CGRectMake(CGRectGetMaxX(rect) - size.width, CGRectGetMinY(rect), size.width, size.height);
+        
+        [key.tintColor setFill];
+        UIRectFill(badge);
+        
+        NSString *text = [NSString stringWithFormat:@"%lu", (unsigned long)(key.selectionIndex + 1)];
+        NSDictionary *attributes = @{NSFontAttributeName : [self fontOfKey:key],
+                                     NSForegroundColorAttributeName : [self attribute:KITAssetOverlayTextColorAttributeName ofKey:key fallback:KITAssetsGridSelectedViewTextColor]};
+        
+        CGSize textSize = [text sizeWithAttributes:attributes];
+        [text drawInRect:[self rect:badge centeringSize:textSize] withAttributes:attributes];
+    }
+    else
+    {
+        UIImage *shadowImage    = [UIImage KITAssetsPickerImageNamed:@"CheckmarkShadow"];
+        UIImage *checkmarkImage = [UIImage KITAssetsPickerImageNamed:@"Checkmark"];
+        
+        CGRect frame = CGRectMake(CGRectGetMaxX(rect) - size.width, CGRectGetMaxY(rect) - size.height, size.width, size.height);
+        
+        [shadowImage drawInRect:frame];
+        [self drawImage:checkmarkImage inRect:[self rect:frame centeringSize:checkmarkImage.size] tintColor:key.tintColor];
+    }
+}
+
+- (UIFont *)fontOfKey:(KITAssetOverlayImageKey *)key
+{
+    return [self attribute:KITAssetOverlayFontAttributeName ofKey:key fallback:KITAssetsGridSelectedViewFont];
+}
+
+- (id)attribute:(NSString *)name ofKey:(KITAssetOverlayImageKey *)key fallback:(id)fallback
+{
+    id value = key.attributes[name];
+    return (value) ? value : fallback;
+}
+
+- (void)drawImage:(UIImage *)image inRect:(CGRect)rect tintColor:(UIColor *)tintColor
+{
+    CGContextRef context = UIGraphicsGetCurrentContext();
+    
+    CGContextSaveGState(context);
+    CGContextBeginTransparencyLayerWithRect(context, rect, NULL);
+    
+    [image drawInRect:rect];
+    [tintColor setFill];
+    UIRectFillUsingBlendMode(rect, kCGBlendModeSourceIn);
+    
+    CGContextEndTransparencyLayer(context);
+    CGContextRestoreGState(context);
+}
+
+- (CGRect)rect:(CGRect)rect centeringSize:(CGSize)size
+{
+    return CGRectMake(CGRectGetMidX(rect) - size.width / 2,
+                      CGRectGetMidY(rect) - size.height / 2,
+                      size.width,
+                      size.height);
+}
+
+@end
@@ -0,0 +1,58 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <UIKit/UIKit.h>
+
+
+
+/**
+ *  Decodes an image while its bytes arrive, giving previews of what has been received so far:
+ *  the scans received of a progressive JPEG, or the top rows of other formats.
+ *
+ *  Previews are bounded by the maximum pixel size like the final image, so no full-resolution bitmap is created.
+ *  The decoder is not thread-safe; use it from one queue.
+ */
+@interface KITAssetProgressiveImageDecoder : NSObject
+
+- (instancetype)initWithMaximumPixelSize:(CGFloat)maximumPixelSize;
+
+@property (nonatomic, assign, readonly) long long receivedLength;
+
+/**
+ *  The bytes appended so far, for the final decode once all are in.
+ */
+@property (nonatomic, strong, readonly) NSData *receivedData;
+
+/**
+ *  Appends the next bytes and returns a new preview when enough has arrived since the last one, or `nil`.
+ *
+ *  @param data           The next bytes, in order.
+ *  @param expectedLength The total length, or a negative value if unknown.
+ */
+- (UIImage *)previewByAppendingData:(NSData *)data expectedLength:(long long)expectedLength;
+
+@end
@@ -0,0 +1,119 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <ImageIO/ImageIO.h>
+#import "KITAssetProgressiveImageDecoder.h"
+
+
+
+
+// previews are decoded at most once per this share of the expected length, or per this many bytes if unknown
+static const double KITAssetProgressiveImageDecoderPreviewStep = 0.1;
+static const long long KITAssetProgressiveImageDecoderPreviewBytes = 256 * 1024;
+
+
+
+@interface KITAssetProgressiveImageDecoder ()
+
+@property (nonatomic, assign) CGFloat maximumPixelSize;
+@property (nonatomic, assign) CGImageSourceRef source;
+@property (nonatomic, strong) NSMutableData *data;
+
+@property (nonatomic, assign, readwrite) long long receivedLength;
+@property (nonatomic, assign) long long previewLength;
+
+@end
+
+
+
+
+
+@implementation KITAssetProgressiveImageDecoder
+
+- (instancetype)initWithMaximumPixelSize:(CGFloat)maximumPixelSize
+{
+    if (self = [super init])
+    {
+        _maximumPixelSize   = maximumPixelSize;
+        _source             = CGImageSourceCreateIncremental(NULL);
+        _data               = [NSMutableData new];
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_source)
+        CFRelease(_source);
+}
+
+- (NSData *)receivedData
+{
+    return self.data;
+}
+
+- (UIImage *)previewByAppendingData:(NSData *)data expectedLength:(long long)expectedLength
+{
+    [self.data appendData:data];
+    self.receivedLength += data.length;
+    
+    long long step = (expectedLength > 0) ?
+    (long long)(expectedLength * KITAssetProgressiveImageDecoderPreviewStep) : KITAssetProgressiveImageDecoderPreviewBytes;
+    
+    BOOL isComplete = (expectedLength > 0 && self.receivedLength >= expectedLength);
+    
+    if (!isComplete && self.receivedLength - self.previewLength < step)
+        return nil;
+    
+    self.previewLength = self.receivedLength;
+    
+    CGImageSourceUpdateData(self.source, (__bridge CFDataRef)self.data, isComplete);
+    
+    // nothing can be shown before the header and the first rows or scan are in
+    CGImageSourceStatus status = CGImageSourceGetStatusAtIndex(self.source, 0);
+    
+    if (status != kCGImageStatusIncomplete && status != kCGImageStatusComplete)
+        return nil;
+    
+    NSDictionary *options = @{(__bridge NSString *)kCGImageSourceCreateThumbnailFromImageAlways : @YES,
+                              (__bridge NSString *)kCGImageSourceCreateThumbnailWithTransform : @YES,
+                              (__bridge NSString *)kCGImageSourceShouldCacheImmediately : @YES,
+                              (__bridge NSString *)kCGImageSourceThumbnailMaxPixelSize : @(MAX(ceil(self.maximumPixelSize), 1))};
+    
+    CGImageRef imageRef = CGImageSourceCreateThumbnailAtIndex(self.source, 0, (__bridge CFDictionaryRef)options);
+    
+    if (!imageRef)
+        return nil;
+    
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:1 orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+    
+    return image;
+}
+
+@end
@@ -33,6 +33,7 @@
 
 
 extern NSString * const KITAssetScrollViewDidTapNotification;
+extern NSString * const KITAssetScrollViewDidEndZoomingNotification;
 
 
 @interface KITAssetScrollView : UIScrollView
@@ -41,6 +42,11 @@ extern NSString * const KITAssetScrollViewDidTapNotification;
 
 @property (nonatomic, strong, readonly) UIImage *image;
 
+/**
+ *  Whether the image is drawn in tiles; see `bindTiledImageData:`.
+ */
+@property (nonatomic, assign, readonly, getter=isTiled) BOOL tiled;
+
 @property (nonatomic, strong, readonly) UIImageView *imageView;
 @property (nonatomic, strong, readonly) KITAssetSelectionButton *selectionButton;
 
@@ -52,6 +58,22 @@ extern NSString * const KITAssetScrollViewDidTapNotification;
 
 - (void)bind:(id<KITAssetDataSource>)asset image:(UIImage *)image requestInfo:(NSDictionary *)info;
 
+/**
+ *  Replaces the bound image with another rendition of the same asset, keeping the zoom and position.
+ */
+- (void)updateImage:(UIImage *)image;
+
+/**
+ *  Draws the bound asset in tiles from its encoded data, so very large images stay sharp when zoomed in
+ *  without decoding them whole. Call it after `bind:image:requestInfo:`.
+ */
+- (void)bindTiledImageData:(NSData *)data;
+
 - (void)updateZoomScalesAndZoom:(BOOL)zoom;
 
+/**
+ *  Clears the bound asset, its image and tiles, and resets the zoom, so another asset can be bound.
+ */
+- (void)prepareForReuse;
+
 @end
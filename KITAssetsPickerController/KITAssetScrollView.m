@@ -27,6 +27,7 @@
 #import <PureLayout/PureLayout.h>
 #import "KITAssetScrollView.h"
 #import "KITAssetPlayButton.h"
+#import "KITAssetTiledImageView.h"
 #import "NSBundle+KITAssetsPickerController.h"
 #import "UIImage+KITAssetsPickerController.h"
 
@@ -34,6 +35,7 @@
 
 
 NSString * const KITAssetScrollViewDidTapNotification = @"KITAssetScrollViewDidTapNotification";
+NSString * const KITAssetScrollViewDidEndZoomingNotification = @"KITAssetScrollViewDidEndZoomingNotification";
 
 
 @interface KITAssetScrollView ()
@@ -47,6 +49,7 @@ NSString * const KITAssetScrollViewDidTapNotification = @"KITAssetScrollViewDidT
 @property (nonatomic, assign) CGFloat perspectiveZoomScale;
 
 @property (nonatomic, strong) UIImageView *imageView;
+@property (nonatomic, strong) KITAssetTiledImageView *tiledImageView;
 
 @property (nonatomic, strong) UIProgressView *progressView;
 @property (nonatomic, strong) UIActivityIndicatorView *activityView;
@@ -215,26 +218,6 @@ NSString * const KITAssetScrollViewDidTapNotification = @"KITAssetScrollViewDidT
     [self.progressView setHidden:(progress == 1)];
 }
 
-// To mimic image downloading progress
-- (void)mimicProgress
-{
-    CGFloat progress = self.progressView.progress;
-
-    if (progress < 0.95)
-    {
-        int lowerbound = progress * 100 + 1;
-        int upperbound = 95;
-        
-        int random = lowerbound + arc4random() % (upperbound - lowerbound);
-        CGFloat randomProgress = random / 100.0f;
-
-        [self setProgress:randomProgress];
-        
-        NSInteger randomDelay = 1 + arc4random() % (3 - 1);
-        [self performSelector:@selector(mimicProgress) withObject:nil afterDelay:randomDelay];
-    }
-}
-
 
 #pragma mark - asset size
 
@@ -266,6 +249,58 @@ NSString * const KITAssetScrollViewDidTapNotification = @"KITAssetScrollViewDidT
 }
 
 
+- (void)updateImage:(UIImage *)image
+{
+    // the content is sized from the asset's pixel size, so any rendition fits the same frame
+    self.image = image;
+    self.imageView.image = image;
+}
+
+
+- (void)bindTiledImageData:(NSData *)data
+{
+    if (self.tiledImageView || !self.asset)
+        return;
+    
+    // the image view keeps the screen-sized image underneath while tiles come in
+    KITAssetTiledImageView *tiledImageView = [[KITAssetTiledImageView alloc] initWithImageData:data pixelSize:[self assetSize]];
+    tiledImageView.frame = self.imageView.bounds;
+    tiledImageView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+    
+    self.tiledImageView = tiledImageView;
+    [self.imageView addSubview:self.tiledImageView];
+    
+    [self updateZoomScalesAndZoom:NO];
+}
+
+- (BOOL)isTiled
+{
+    return (self.tiledImageView != nil);
+}
+
+
+#pragma mark - Reuse
+
+- (void)prepareForReuse
+{
+    self.asset              = nil;
+    self.image              = nil;
+    self.imageView.image    = nil;
+    
+    [self.tiledImageView removeFromSuperview];
+    self.tiledImageView = nil;
+    
+    // the scales of the next asset are set when it is bound
+    self.minimumZoomScale   = 1;
+    self.maximumZoomScale   = 1;
+    self.zoomScale          = 1;
+    self.contentOffset      = CGPointZero;
+    self.scrollEnabled      = YES;
+    
+    [self setNeedsUpdateConstraints];
+}
+
+
 #pragma mark - Upate zoom scales
 
 - (void)updateZoomScalesAndZoom:(BOOL)zoom
@@ -282,6 +317,10 @@ NSString * const KITAssetScrollViewDidTapNotification = @"KITAssetScrollViewDidT
     CGFloat minScale = MIN(xScale, yScale);
     CGFloat maxScale = 3.0 * minScale;
     
+    // tiles stay sharp down to one image pixel per device pixel
+    if (self.isTiled)
+        maxScale = MAX(maxScale, 1.0 / UIScreen.mainScreen.scale);
+    
     
     self.minimumZoomScale = minScale;
     self.maximumZoomScale = maxScale;
@@ -460,6 +499,12 @@ NSString * const KITAssetScrollViewDidTapNotification = @"KITAssetScrollViewDidT
 }
 
 
+- (void)scrollViewDidEndZooming:(UIScrollView *)scrollView withView:(UIView *)view atScale:(CGFloat)scale
+{
+    [[NSNotificationCenter defaultCenter] postNotificationName:KITAssetScrollViewDidEndZoomingNotification object:self];
+}
+
+
 #pragma mark - Gesture recognizer delegate
 
 - (BOOL)gestureRecognizer:(UIGestureRecognizer *)gestureRecognizer shouldReceiveTouch:(UITouch *)touch
@@ -0,0 +1,95 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <UIKit/UIKit.h>
+#import "KITAssetDataSource.h"
+#import "KITAssetImageResampler.h"
+
+
+
+/**
+ *  Produces thumbnails for assets whose data source does not implement `thumbnailImageWithCompletionHandler:`.
+ *
+ *  The image data is decoded through ImageIO to twice the target size, which does most of the downsampling
+ *  without ever allocating a full-size bitmap, and `KITAssetImageResample` filters the remaining step in one pass.
+ *  A couple of images are made at a time off the main thread. Generated thumbnails are cached by asset and size.
+ */
+@interface KITAssetThumbnailGenerator : NSObject
+
+/**
+ *  The filter used to downsample the decoded image. `KITAssetImageResamplerFilterBox` by default.
+ */
+@property (nonatomic, assign) KITAssetImageResamplerFilter filter;
+
++ (instancetype)sharedGenerator;
+
+/**
+ *  Requests a thumbnail for the asset.
+ *
+ *  Uses the data source's own `thumbnailImageWithCompletionHandler:` when it is implemented,
+ *  otherwise generates one from `dataWithCompletionHandler:`.
+ *
+ *  @param asset      The asset.
+ *  @param targetSize The size in pixels the thumbnail has to fill (aspect fill).
+ *  @param handler    Called on the main queue with the thumbnail, or `nil` if it could not be made.
+ */
+- (void)requestThumbnailForAsset:(id<KITAssetDataSource>)asset targetSize:(CGSize)targetSize completionHandler:(void(^)(UIImage *image))handler;
+
+/**
+ *  Returns the largest thumbnail of the asset already cached at a size class no larger than `maximumSize`,
+ *  without generating anything.
+ *
+ *  @param asset       The asset.
+ *  @param maximumSize The size in pixels.
+ *
+ *  @return The cached thumbnail, or `nil` if there is none or the data source makes its own thumbnails.
+ */
+- (UIImage *)cachedThumbnailForAsset:(id<KITAssetDataSource>)asset maximumSize:(CGSize)maximumSize;
+
+/**
+ *  Rounds a target size up to its thumbnail size class.
+ *
+ *  Nearby sizes, such as the item sizes of neighbouring grid densities, share a size class
+ *  and therefore share cached thumbnails, while a denser grid still gets a smaller class.
+ *
+ *  @param targetSize The size in pixels.
+ *
+ *  @return The size class in pixels, with the aspect ratio of `targetSize`.
+ */
++ (CGSize)sizeClassForTargetSize:(CGSize)targetSize;
+
+/**
+ *  Downsamples an image so that it fills the target size, without ever upscaling.
+ *
+ *  @param image      The image to downsample.
+ *  @param targetSize The size in pixels.
+ *
+ *  @return The downsampled image, or `image` itself if it is already small enough.
+ */
+- (UIImage *)thumbnailFromImage:(UIImage *)image targetSize:(CGSize)targetSize;
+
+@end
@@ -0,0 +1,304 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetThumbnailGenerator.h"
+#import "UIImage+KITAssetsPickerController.h"
+
+
+
+
+// each generation holds a decoded bitmap, so a fast scroll must not start one per cell at once
+static const NSInteger KITAssetThumbnailGeneratorMaxConcurrentGenerations = 2;
+
+// decoded at this multiple of the thumbnail size; ImageIO's scaled decode does the bulk of the reduction
+// without a full-size bitmap, and the resampler filters the last step
+static const CGFloat KITAssetThumbnailGeneratorDecodeScale = 2;
+
+// the longer side in pixels of each thumbnail size class, smallest first
+static const CGFloat KITAssetThumbnailGeneratorSizeClasses[] = {64, 96, 128, 192, 256, 384, 512};
+static const size_t KITAssetThumbnailGeneratorNumberOfSizeClasses = sizeof(KITAssetThumbnailGeneratorSizeClasses) / sizeof(KITAssetThumbnailGeneratorSizeClasses[0]);
+
+
+
+// Identifies a thumbnail by the asset object and the size. The asset is held weakly, so an entry of a
+// deallocated asset never matches a new asset that happens to reuse its address.
+@interface KITAssetThumbnailCacheKey : NSObject <NSCopying>
+
+@property (nonatomic, weak, readonly) id<KITAssetDataSource> asset;
+@property (nonatomic, assign, readonly) CGSize targetSize;
+@property (nonatomic, assign, readonly) NSUInteger assetHash;
+
+@end
+
+
+@implementation KITAssetThumbnailCacheKey
+
+- (instancetype)initWithAsset:(id<KITAssetDataSource>)asset targetSize:(CGSize)targetSize
+{
+    if (self = [super init])
+    {
+        _asset      = asset;
+        _targetSize = targetSize;
+        _assetHash  = (NSUInteger)(__bridge void *)asset;
+    }
+    
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    return self;
+}
+
+- (NSUInteger)hash
+{
+    return self.assetHash ^ (NSUInteger)(self.targetSize.width * 31 + self.targetSize.height);
+}
+
+- (BOOL)isEqual:(id)object
+{
+    if (![object isKindOfClass:[KITAssetThumbnailCacheKey class]])
+        return NO;
+    
+    KITAssetThumbnailCacheKey *key = object;
+    id<KITAssetDataSource> asset = self.asset;
+    
+    return (asset && asset == key.asset && CGSizeEqualToSize(self.targetSize, key.targetSize));
+}
+
+@end
+
+
+
+
+
+@interface KITAssetThumbnailGenerator ()
+
+@property (nonatomic, strong) NSOperationQueue *queue;
+@property (nonatomic, strong) NSCache *cache;
+
+@end
+
+
+
+
+
+@implementation KITAssetThumbnailGenerator
+
++ (instancetype)sharedGenerator
+{
+    static KITAssetThumbnailGenerator *generator;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        generator = [self new];
+    });
+    
+    return generator;
+}
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        _filter = KITAssetImageResamplerFilterBox;
+        _queue  = [NSOperationQueue new];
+        _cache  = [NSCache new];
+        _cache.countLimit = 500;
+        
+        _queue.name = @"ly.kite.KITAssetsPickerController.thumbnails";
+        _queue.maxConcurrentOperationCount = KITAssetThumbnailGeneratorMaxConcurrentGenerations;
+        
+        if ([_queue respondsToSelector:@selector(setQualityOfService:)])
+            _queue.qualityOfService = NSQualityOfServiceUserInitiated;
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Request thumbnail
+
+- (void)requestThumbnailForAsset:(id<KITAssetDataSource>)asset targetSize:(CGSize)targetSize completionHandler:(void (^)(UIImage *))handler
+{
+    if ([asset respondsToSelector:@selector(thumbnailImageWithCompletionHandler:)])
+    {
+        [asset thumbnailImageWithCompletionHandler:handler];
+        return;
+    }
+    
+    KITAssetThumbnailCacheKey *key = [[KITAssetThumbnailCacheKey alloc] initWithAsset:asset targetSize:targetSize];
+    UIImage *cachedImage = [self.cache objectForKey:key];
+    
+    if (cachedImage)
+    {
+        handler(cachedImage);
+        return;
+    }
+    
+    CGSize pixelSize = CGSizeMake(asset.pixelWidth, asset.pixelHeight);
+    
+    [asset dataWithCompletionHandler:^(NSData *data, NSError *error){
+        [self.queue addOperationWithBlock:^{
+            UIImage *image = [self thumbnailFromData:data pixelSize:pixelSize targetSize:targetSize];
+            
+            if (image)
+                [self.cache setObject:image forKey:key];
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                handler(image);
+            });
+        }];
+    }];
+}
+
+- (UIImage *)cachedThumbnailForAsset:(id<KITAssetDataSource>)asset maximumSize:(CGSize)maximumSize
+{
+    if ([asset respondsToSelector:@selector(thumbnailImageWithCompletionHandler:)])
+        return nil;
+    
+    CGFloat length = MAX(maximumSize.width, maximumSize.height);
+    
+    if (length <= 0)
+        return nil;
+    
+    // the largest size class first, the sharpest of what is already there
+    for (size_t i = KITAssetThumbnailGeneratorNumberOfSizeClasses; i > 0; i--)
+    {
+        CGFloat sizeClass = KITAssetThumbnailGeneratorSizeClasses[i - 1];
+        
+        if (sizeClass > length)
+            continue;
+        
+        CGSize size = [self.class sizeOfSizeClass:sizeClass forTargetSize:maximumSize];
+        KITAssetThumbnailCacheKey *key = [[KITAssetThumbnailCacheKey alloc] initWithAsset:asset targetSize:size];
+        UIImage *image = [self.cache objectForKey:key];
+        
+        if (image)
+            return image;
+    }
+    
+    return nil;
+}
+
++ (CGSize)sizeClassForTargetSize:(CGSize)targetSize
+{
+    CGFloat length = MAX(targetSize.width, targetSize.height);
+    
+    if (length <= 0)
+        return targetSize;
+    
+    for (size_t i = 0; i < KITAssetThumbnailGeneratorNumberOfSizeClasses; i++)
+    {
+        if (length <= KITAssetThumbnailGeneratorSizeClasses[i])
+            return [self sizeOfSizeClass:KITAssetThumbnailGeneratorSizeClasses[i] forTargetSize:targetSize];
+    }
+    
+    return CGSizeMake(ceil(targetSize.width), ceil(targetSize.height));
+}
+
++ (CGSize)sizeOfSizeClass:(CGFloat)sizeClass forTargetSize:(CGSize)targetSize
+{
+    CGFloat factor = sizeClass / MAX(targetSize.width, targetSize.height);
+    return CGSizeMake(ceil(targetSize.width * factor), ceil(targetSize.height * factor));
+}
+
+#pragma mark - Generate thumbnail
+
+- (UIImage *)thumbnailFromData:(NSData *)data pixelSize:(CGSize)pixelSize targetSize:(CGSize)targetSize
+{
+    if (data.length == 0)
+        return nil;
+    
+    // the longer side of the image when it fills the target; without the asset's size, a generous guess
+    CGFloat maximumPixelSize = MAX(targetSize.width, targetSize.height) * 4;
+    
+    if (pixelSize.width > 0 && pixelSize.height > 0)
+    {
+        CGFloat scale = MAX(targetSize.width / pixelSize.width, targetSize.height / pixelSize.height);
+        maximumPixelSize = MAX(pixelSize.width, pixelSize.height) * scale;
+    }
+    
+    // decoded through ImageIO straight to a small bitmap, never the full-resolution one
+    UIImage *image = [UIImage KITAssetsPickerImageWithData:data
+                                          maximumPixelSize:ceil(maximumPixelSize * KITAssetThumbnailGeneratorDecodeScale)];
+    
+    return [self thumbnailFromImage:image targetSize:targetSize];
+}
+
+- (UIImage *)thumbnailFromImage:(UIImage *)image targetSize:(CGSize)targetSize
+{
+    CGImageRef sourceImage = image.CGImage;
+    
+    if (!sourceImage)
+        return nil;
+    
+    size_t srcWidth     = CGImageGetWidth(sourceImage);
+    size_t srcHeight    = CGImageGetHeight(sourceImage);
+    
+    // aspect fill the target, never upscale
+    CGFloat scale = MAX(targetSize.width / srcWidth, targetSize.height / srcHeight);
+    
+    if (scale >= 1 || srcWidth == 0 || srcHeight == 0)
+        return image;
+    
+    size_t dstWidth     = MAX((size_t)1, (size_t)ceil(srcWidth * scale));
+    size_t dstHeight    = MAX((size_t)1, (size_t)ceil(srcHeight * scale));
+    
+    CGColorSpaceRef colorSpace  = CGColorSpaceCreateDeviceRGB();
+    CGBitmapInfo bitmapInfo     = kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big;
+    
+    CGContextRef srcContext = CGBitmapContextCreate(NULL, srcWidth, srcHeight, 8, 0, colorSpace, bitmapInfo);
+    CGContextRef dstContext = CGBitmapContextCreate(NULL, dstWidth, dstHeight, 8, 0, colorSpace, bitmapInfo);
+    CGColorSpaceRelease(colorSpace);
+    
+    UIImage *thumbnail = nil;
+    
+    if (srcContext && dstContext)
+    {
+        CGContextDrawImage(srcContext, CGRectMake(0, 0, srcWidth, srcHeight), sourceImage);
+        
+        BOOL success =
+        KITAssetImageResample(CGBitmapContextGetData(srcContext), srcWidth, srcHeight, CGBitmapContextGetBytesPerRow(srcContext),
+                              CGBitmapContextGetData(dstContext), dstWidth, dstHeight, CGBitmapContextGetBytesPerRow(dstContext),
+                              self.filter);
+        
+        if (success)
+        {
+            CGImageRef thumbnailImage = CGBitmapContextCreateImage(dstContext);
+            thumbnail = [UIImage imageWithCGImage:thumbnailImage scale:1 orientation:image.imageOrientation];
+            CGImageRelease(thumbnailImage);
+        }
+    }
+    
+    CGContextRelease(srcContext);
+    CGContextRelease(dstContext);
+    
+    return thumbnail;
+}
+
+@end
@@ -24,7 +24,6 @@
  
  */
 
-#import <PureLayout/PureLayout.h>
 #import "KITAssetThumbnailOverlay.h"
 #import "UIImage+KITAssetsPickerController.h"
 #import "KITAssetCollectionDataSource.h"
@@ -36,8 +35,6 @@
 @property (nonatomic, strong) UIImageView *badge;
 @property (nonatomic, strong) UILabel *duration;
 
-@property (nonatomic, assign) BOOL didSetupConstraints;
-
 @end
 
 
@@ -63,19 +60,19 @@
 
 - (void)setupViews
 {
-    UIImageView *gradient = [UIImageView newAutoLayoutView];
+    UIImageView *gradient = [UIImageView new];
     gradient.image = [UIImage KITAssetsPickerImageNamed:@"GridGradient"];
     self.gradient = gradient;
     
     [self addSubview:self.gradient];
     
-    UIImageView *badge = [UIImageView newAutoLayoutView];
+    UIImageView *badge = [UIImageView new];
     badge.tintColor = [UIColor whiteColor];
     self.badge = badge;
     
     [self addSubview:self.badge];
     
-    UILabel *duration = [UILabel newAutoLayoutView];
+    UILabel *duration = [UILabel new];
     duration.font = [UIFont preferredFontForTextStyle:UIFontTextStyleCaption2];
     duration.textColor = [UIColor whiteColor];
     duration.lineBreakMode = NSLineBreakByTruncatingTail;
@@ -85,24 +82,27 @@
     [self addSubview:self.duration];
 }
 
-#pragma mark - Update auto layout constraints
+#pragma mark - Layout
 
-- (void)updateConstraints
+- (void)layoutSubviews
 {
-    if (!self.didSetupConstraints)
-    {
-        [self.gradient autoPinEdgesToSuperviewEdgesWithInsets:UIEdgeInsetsZero excludingEdge:ALEdgeTop];
-        [self.gradient autoSetDimension:ALDimensionHeight toSize:self.gradient.image.size.height];
-        [self.badge autoPinEdgeToSuperviewEdge:ALEdgeLeft withInset:8];
-        [self.badge autoPinEdgeToSuperviewEdge:ALEdgeBottom withInset:8];
-        [self.duration autoPinEdgeToSuperviewEdge:ALEdgeRight withInset:8];
-        [self.duration autoPinEdgeToSuperviewEdge:ALEdgeBottom withInset:8];
-        
-        
-        self.didSetupConstraints = YES;
-    }
+    [super layoutSubviews];
+    
+    CGRect bounds   = self.bounds;
+    CGFloat inset   = 8;
+    
+    CGFloat gradientHeight = self.gradient.image.size.height;
+    self.gradient.frame = CGRectMake(0, CGRectGetHeight(bounds) - gradientHeight, CGRectGetWidth(bounds), gradientHeight);
+    
+    CGSize badgeSize = [self.badge sizeThatFits:bounds.size];
+    self.badge.frame = CGRectMake(inset, CGRectGetHeight(bounds) - inset - badgeSize.height, badgeSize.width, badgeSize.height);
     
-    [super updateConstraints];
+    CGSize durationSize = [self.duration sizeThatFits:bounds.size];
+    durationSize.width  = MIN(durationSize.width, MAX(0, CGRectGetWidth(bounds) - inset * 2));
+    self.duration.frame = CGRectMake(CGRectGetWidth(bounds) - inset - durationSize.width,
+                                     CGRectGetHeight(bounds) - inset - durationSize.height,
+                                     durationSize.width,
+                                     durationSize.height);
 }
 
 
@@ -113,8 +113,7 @@
 //    self.badge.layoutMargins = [self layoutMarginsForAsset:asset];
     self.duration.text = duration;
     
-    [self setNeedsUpdateConstraints];
-    [self updateConstraintsIfNeeded];
+    [self setNeedsLayout];
 }
 
 - (UIEdgeInsets)layoutMarginsForAsset:(id<KITAssetDataSource> )asset
@@ -130,8 +129,7 @@
 //    self.badge.layoutMargins = [self layoutMarginsForAssetCollection:assetCollection];
     self.duration.text = nil;
     
-    [self setNeedsUpdateConstraints];
-    [self updateConstraintsIfNeeded];    
+    [self setNeedsLayout];
 }
 
 - (UIEdgeInsets)layoutMarginsForAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
@@ -24,7 +24,6 @@
  
  */
 
-#import <PureLayout/PureLayout.h>
 #import "KITAssetsPickerDefines.h"
 #import "KITAssetThumbnailView.h"
 #import "KITAssetThumbnailOverlay.h"
@@ -38,8 +37,6 @@
 @property (nonatomic, strong) UIImageView *imageView;
 @property (nonatomic, strong) UIImageView *backgroundView;
 
-@property (nonatomic, assign) BOOL didSetupConstraints;
-
 @end
 
 
@@ -90,30 +87,17 @@
 }
 
 
-#pragma markt - Override set bounds
+#pragma mark - Layout
 
--(void)setBounds:(CGRect)bounds
+- (void)layoutSubviews
 {
-    [super setBounds:bounds];
+    [super layoutSubviews];
     
-    [self.overlay setFrame:bounds];
-    [self.overlay setNeedsDisplay];
-}
-
-
-#pragma mark - Update auto layout constraints
-
-- (void)updateConstraints
-{
-    if (!self.didSetupConstraints)
-    {
-        [self.backgroundView autoPinEdgesToSuperviewEdgesWithInsets:UIEdgeInsetsZero];
-        [self.imageView autoPinEdgesToSuperviewEdgesWithInsets:UIEdgeInsetsZero];
-        
-        self.didSetupConstraints = YES;
-    }
+    CGRect bounds = self.bounds;
     
-    [super updateConstraints];
+    self.backgroundView.frame   = bounds;
+    self.imageView.frame        = bounds;
+    self.overlay.frame          = bounds;
 }
 
 #pragma - Bind asset and image
@@ -124,9 +108,6 @@
     
     self.imageView.image = image;
     self.backgroundView.hidden = (image != nil);
-    
-    [self setNeedsUpdateConstraints];
-    [self updateConstraintsIfNeeded];
 }
 
 - (void)setupOverlayForAsset:(id<KITAssetDataSource> )asset
@@ -144,9 +125,6 @@
     
     self.imageView.image = image;
     self.backgroundView.hidden = (image != nil);
-    
-    [self setNeedsUpdateConstraints];
-    [self updateConstraintsIfNeeded];
 }
 
 - (void)setupOverlayForAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
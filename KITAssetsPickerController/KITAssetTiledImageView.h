@@ -0,0 +1,55 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <UIKit/UIKit.h>
+
+
+
+/**
+ *  Draws a very large image in tiles, decoding only what the visible rect needs at the current zoom.
+ *
+ *  The image is kept as encoded data and decoded into a pyramid of levels, each half the size of the one above.
+ *  Tiles are drawn on background threads by a `CATiledLayer` from the coarsest level sharp enough for the zoom.
+ *  Decoded levels are cached by their memory cost. Levels larger than `KITAssetTiledImageViewMaximumLevelBytes`
+ *  are never decoded whole: their tiles are decoded from the data where they are drawn, which is slower but keeps
+ *  the deepest zoom sharp. Images with an EXIF orientation other than up stop at the finest level within the
+ *  budget, so their deepest zoom may show a downsampled image.
+ *
+ *  The view's bounds may have any size; they are mapped onto the whole image.
+ */
+@interface KITAssetTiledImageView : UIView
+
+- (instancetype)initWithImageData:(NSData *)data pixelSize:(CGSize)pixelSize;
+
+@property (nonatomic, assign, readonly) CGSize pixelSize;
+
+/**
+ *  Whether an image of this size is worth drawing in tiles.
+ */
++ (BOOL)shouldTileImageWithPixelSize:(CGSize)pixelSize;
+
+@end
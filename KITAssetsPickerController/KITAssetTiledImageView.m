@@ -0,0 +1,295 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <QuartzCore/QuartzCore.h>
+#import <ImageIO/ImageIO.h>
+#import "KITAssetsPickerDefines.h"
+#import "KITAssetTiledImageView.h"
+#import "UIImage+KITAssetsPickerController.h"
+
+
+
+@interface KITAssetTiledImageView ()
+
+@property (nonatomic, copy) NSData *data;
+@property (nonatomic, assign, readwrite) CGSize pixelSize;
+
+// level 0 is the original size; each level halves the one before
+@property (nonatomic, assign) NSUInteger numberOfLevels;
+@property (nonatomic, assign) NSUInteger finestLevel;
+@property (nonatomic, assign) NSUInteger finestDecodedLevel;
+@property (nonatomic, strong) NSCache *levels;
+
+// guards the caches below; decodes run outside it
+@property (nonatomic, strong) NSCondition *levelsCondition;
+@property (nonatomic, strong) NSMutableIndexSet *decodingLevels;
+@property (nonatomic, strong) NSMutableDictionary *regionImages;
+
+@end
+
+
+
+
+
+@implementation KITAssetTiledImageView
+{
+    CGImageSourceRef _source;
+}
+
++ (Class)layerClass
+{
+    return [CATiledLayer class];
+}
+
++ (BOOL)shouldTileImageWithPixelSize:(CGSize)pixelSize
+{
+    return (MAX(pixelSize.width, pixelSize.height) >= KITAssetTiledImageViewMinimumPixelSize);
+}
+
+- (instancetype)initWithImageData:(NSData *)data pixelSize:(CGSize)pixelSize
+{
+    if (self = [super initWithFrame:CGRectMake(0, 0, pixelSize.width, pixelSize.height)])
+    {
+        _data       = [data copy];
+        _pixelSize  = pixelSize;
+        
+        _levels = [NSCache new];
+        _levels.totalCostLimit = KITAssetTiledImageViewCacheBytes;
+        
+        _levelsCondition    = [NSCondition new];
+        _decodingLevels     = [NSMutableIndexSet new];
+        _regionImages       = [NSMutableDictionary new];
+        
+        [self setupSource];
+        [self setupLevels];
+        [self setupTiledLayer];
+        
+        self.opaque = NO;
+        self.userInteractionEnabled = NO;
+    }
+    
+    return self;
+}
+
+
+- (void)dealloc
+{
+    if (_source)
+        CFRelease(_source);
+}
+
+
+#pragma mark - Setup
+
+// Levels over the budget are drawn tile by tile straight from the encoded data. That needs the data in its
+// stored orientation, so images with an EXIF rotation keep to the levels that are decoded whole.
+- (void)setupSource
+{
+    NSDictionary *options = @{(__bridge NSString *)kCGImageSourceShouldCache : @NO};
+    CGImageSourceRef source = CGImageSourceCreateWithData((__bridge CFDataRef)self.data, (__bridge CFDictionaryRef)options);
+    
+    if (!source)
+        return;
+    
+    NSDictionary *properties = CFBridgingRelease(CGImageSourceCopyPropertiesAtIndex(source, 0, NULL));
+    NSInteger orientation = [properties[(__bridge NSString *)kCGImagePropertyOrientation] integerValue];
+    
+    if (orientation > 1)
+    {
+        CFRelease(source);
+        return;
+    }
+    
+    _source = source;
+}
+
+- (void)setupLevels
+{
+    CGFloat screenPixelSize = MAX(CGRectGetWidth(UIScreen.mainScreen.bounds), CGRectGetHeight(UIScreen.mainScreen.bounds)) * UIScreen.mainScreen.scale;
+    CGFloat imagePixelSize  = MAX(self.pixelSize.width, self.pixelSize.height);
+    
+    // down to the level that fits the screen, which is what the minimum zoom shows
+    NSUInteger numberOfLevels = 1;
+    
+    while (imagePixelSize / (1 << (numberOfLevels - 1)) > screenPixelSize && numberOfLevels < 16)
+        numberOfLevels++;
+    
+    // levels too large for the budget are never decoded whole
+    NSUInteger finestDecodedLevel = 0;
+    
+    while (finestDecodedLevel + 1 < numberOfLevels && [self costOfLevel:finestDecodedLevel] > KITAssetTiledImageViewMaximumLevelBytes)
+        finestDecodedLevel++;
+    
+    self.numberOfLevels     = numberOfLevels;
+    self.finestDecodedLevel = finestDecodedLevel;
+    self.finestLevel        = (_source) ? 0 : finestDecodedLevel;
+}
+
+- (void)setupTiledLayer
+{
+    CATiledLayer *layer = (CATiledLayer *)self.layer;
+    CGFloat tileSize = KITAssetTiledImageViewTileSize * UIScreen.mainScreen.scale;
+    
+    layer.tileSize          = CGSizeMake(tileSize, tileSize);
+    layer.levelsOfDetail    = self.numberOfLevels;
+}
+
+- (CGFloat)costOfLevel:(NSUInteger)level
+{
+    CGFloat factor = (CGFloat)(1 << level);
+    return ceil(self.pixelSize.width / factor) * ceil(self.pixelSize.height / factor) * 4;
+}
+
+
+#pragma mark - Levels
+
+// the coarsest level that still gives every device pixel an image pixel
+- (NSUInteger)levelForDevicePixelsPerImagePixel:(CGFloat)devicePixelsPerImagePixel
+{
+    NSUInteger level = self.finestLevel;
+    
+    while (level + 1 < self.numberOfLevels && devicePixelsPerImagePixel * (1 << (level + 1)) <= 1)
+        level++;
+    
+    return level;
+}
+
+- (CGImageRef)copyImageForLevel:(NSUInteger)level
+{
+    if (level < self.finestDecodedLevel)
+        return [self copyRegionImageForLevel:level];
+    
+    NSNumber *key = @(level);
+    NSCondition *condition = self.levelsCondition;
+    id cachedImage = nil;
+    
+    // tiles are drawn on several threads; one decode per level is enough, and tiles of other levels never wait for it
+    [condition lock];
+    
+    while (!(cachedImage = [self.levels objectForKey:key]) && [self.decodingLevels containsIndex:level])
+        [condition wait];
+    
+    if (cachedImage)
+    {
+        CGImageRef imageRef = CGImageRetain((__bridge CGImageRef)cachedImage);
+        [condition unlock];
+        
+        return imageRef;
+    }
+    
+    [self.decodingLevels addIndex:level];
+    [condition unlock];
+    
+    CGFloat maximumPixelSize = MAX(self.pixelSize.width, self.pixelSize.height) / (1 << level);
+    UIImage *image = [UIImage KITAssetsPickerImageWithData:self.data maximumPixelSize:maximumPixelSize];
+    CGImageRef imageRef = CGImageRetain(image.CGImage);
+    
+    [condition lock];
+    
+    if (imageRef)
+        [self.levels setObject:(__bridge id)imageRef forKey:key cost:CGImageGetBytesPerRow(imageRef) * CGImageGetHeight(imageRef)];
+    
+    [self.decodingLevels removeIndex:level];
+    [condition broadcast];
+    [condition unlock];
+    
+    return imageRef;
+}
+
+// An image of the level that is decoded only where it is drawn, and again each time; JPEG sources subsample
+// while decoding, others decode at the original size and are scaled when drawn.
+- (CGImageRef)copyRegionImageForLevel:(NSUInteger)level
+{
+    NSNumber *key = @(level);
+    NSCondition *condition = self.levelsCondition;
+    
+    [condition lock];
+    
+    id image = self.regionImages[key];
+    
+    if (!image && _source)
+    {
+        NSMutableDictionary *options = [NSMutableDictionary dictionaryWithObject:@NO forKey:(__bridge NSString *)kCGImageSourceShouldCache];
+        
+        // ImageIO subsamples by 2, 4 or 8 only
+        if (level > 0 && &kCGImageSourceSubsampleFactor != NULL)
+            options[(__bridge NSString *)kCGImageSourceSubsampleFactor] = @(1 << MIN(level, 3));
+        
+        image = CFBridgingRelease(CGImageSourceCreateImageAtIndex(_source, 0, (__bridge CFDictionaryRef)options));
+        
+        if (image)
+            self.regionImages[key] = image;
+    }
+    
+    CGImageRef imageRef = CGImageRetain((__bridge CGImageRef)image);
+    [condition unlock];
+    
+    return imageRef;
+}
+
+
+#pragma mark - Drawing
+
+- (void)drawRect:(CGRect)rect
+{
+    CGContextRef context = UIGraphicsGetCurrentContext();
+    CGSize boundsSize = self.bounds.size;
+    
+    if (boundsSize.width <= 0 || boundsSize.height <= 0)
+        return;
+    
+    CGFloat devicePixelsPerPoint        = fabs(CGContextGetCTM(context).a);
+    CGFloat devicePixelsPerImagePixel   = devicePixelsPerPoint * boundsSize.width / self.pixelSize.width;
+    
+    CGImageRef levelImage = [self copyImageForLevel:[self levelForDevicePixelsPerImagePixel:devicePixelsPerImagePixel]];
+    
+    if (!levelImage)
+        return;
+    
+    // the tile rect in the level's pixels, grown to whole pixels
+    CGFloat xFactor = CGImageGetWidth(levelImage) / boundsSize.width;
+    CGFloat yFactor = CGImageGetHeight(levelImage) / boundsSize.height;
+    
+    CGRect levelRect = CGRectIntegral(CGRectMake(CGRectGetMinX(rect) * xFactor, CGRectGetMinY(rect) * yFactor,
+                                                 CGRectGetWidth(rect) * xFactor, CGRectGetHeight(rect) * yFactor));
+    
+    levelRect = CGRectIntersection(levelRect, CGRectMake(0, 0, CGImageGetWidth(levelImage), CGImageGetHeight(levelImage)));
+    
+    CGImageRef tileImage = CGImageCreateWithImageInRect(levelImage, levelRect);
+    CGImageRelease(levelImage);
+    
+    if (!tileImage)
+        return;
+    
+    CGRect tileRect = CGRectMake(CGRectGetMinX(levelRect) / xFactor, CGRectGetMinY(levelRect) / yFactor,
+                                 CGRectGetWidth(levelRect) / xFactor, CGRectGetHeight(levelRect) / yFactor);
+    
+    [[UIImage imageWithCGImage:tileImage] drawInRect:tileRect];
+    CGImageRelease(tileImage);
+}
+
+@end
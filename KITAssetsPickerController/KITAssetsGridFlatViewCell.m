@@ -0,0 +1,260 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetsPickerDefines.h"
+#import "KITAssetsGridFlatViewCell.h"
+#import "KITAssetOverlayImageCache.h"
+
+
+
+@interface KITAssetsGridFlatViewCell ()
+
+@property (nonatomic, strong) CALayer *overlayLayer;
+
+@property (nonatomic, strong) UIColor *flatDisabledColor;
+@property (nonatomic, strong) UIColor *flatHighlightedColor;
+@property (nonatomic, copy) NSDictionary *overlayAttributes;
+
+@end
+
+
+
+
+
+@implementation KITAssetsGridFlatViewCell
+
+- (instancetype)initWithFrame:(CGRect)frame
+{
+    if (self = [super initWithFrame:frame])
+    {
+        [self updateOverlay];
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Setup
+
+- (void)setupViews
+{
+    _flatDisabledColor      = KITAssetsGridViewCellDisabledColor;
+    _flatHighlightedColor   = KITAssetsGridViewCellHighlightedColor;
+    [self updateOverlayAttributes];
+    
+    CALayer *thumbnailLayer = self.contentView.layer;
+    thumbnailLayer.backgroundColor  = KITAssetsPikcerThumbnailBackgroundColor.CGColor;
+    thumbnailLayer.contentsGravity  = kCAGravityResizeAspectFill;
+    thumbnailLayer.masksToBounds    = YES;
+    
+    // standalone layers animate every change implicitly, which we never want while scrolling
+    CALayer *overlayLayer = [CALayer layer];
+    overlayLayer.contentsScale  = UIScreen.mainScreen.scale;
+    overlayLayer.actions        = @{@"contents" : [NSNull null],
+                                    @"hidden"   : [NSNull null],
+                                    @"bounds"   : [NSNull null],
+                                    @"position" : [NSNull null]};
+    overlayLayer.hidden         = YES;
+    self.overlayLayer = overlayLayer;
+    [self.contentView.layer addSublayer:overlayLayer];
+}
+
+- (void)layoutSubviews
+{
+    [super layoutSubviews];
+    
+    if (!CGRectEqualToRect(self.overlayLayer.frame, self.contentView.bounds))
+    {
+        self.overlayLayer.frame = self.contentView.bounds;
+        [self updateOverlay];
+    }
+}
+
+
+#pragma mark - Apperance
+
+- (UIColor *)disabledColor
+{
+    return self.flatDisabledColor;
+}
+
+- (void)setDisabledColor:(UIColor *)disabledColor
+{
+    self.flatDisabledColor = (disabledColor) ? disabledColor : KITAssetsGridViewCellDisabledColor;
+    [self updateOverlayAttributes];
+    [self updateOverlay];
+}
+
+- (UIColor *)highlightedColor
+{
+    return self.flatHighlightedColor;
+}
+
+- (void)setHighlightedColor:(UIColor *)highlightedColor
+{
+    self.flatHighlightedColor = (highlightedColor) ? highlightedColor : KITAssetsGridViewCellHighlightedColor;
+    [self updateOverlayAttributes];
+    [self updateOverlay];
+}
+
+- (void)tintColorDidChange
+{
+    [super tintColorDidChange];
+    [self updateOverlay];
+}
+
+
+#pragma mark - Accessors
+
+- (void)setEnabled:(BOOL)enabled
+{
+    BOOL changed = (enabled != self.isEnabled);
+    [super setEnabled:enabled];
+    
+    if (changed)
+        [self updateOverlay];
+}
+
+- (void)setHighlighted:(BOOL)highlighted
+{
+    BOOL changed = (highlighted != self.isHighlighted);
+    [super setHighlighted:highlighted];
+    
+    if (changed)
+        [self updateOverlay];
+}
+
+- (void)setSelected:(BOOL)selected
+{
+    BOOL changed = (selected != self.isSelected);
+    [super setSelected:selected];
+    
+    if (changed)
+        [self updateOverlay];
+}
+
+- (void)setShowsSelectionIndex:(BOOL)showsSelectionIndex
+{
+    BOOL changed = (showsSelectionIndex != self.showsSelectionIndex);
+    [super setShowsSelectionIndex:showsSelectionIndex];
+    
+    if (changed && self.isSelected)
+        [self updateOverlay];
+}
+
+- (void)setSelectionIndex:(NSUInteger)selectionIndex
+{
+    BOOL changed = (selectionIndex != self.selectionIndex);
+    [super setSelectionIndex:selectionIndex];
+    
+    if (changed && self.isSelected && self.showsSelectionIndex)
+        [self updateOverlay];
+}
+
+
+#pragma mark - Overlay
+
+- (void)updateOverlay
+{
+    CALayer *overlayLayer = self.overlayLayer;
+    
+    if (!overlayLayer)
+        return;
+    
+    BOOL visible = (!self.isEnabled || self.isHighlighted || self.isSelected);
+    
+    if (visible && !CGRectIsEmpty(overlayLayer.bounds))
+    {
+        UIImage *image =
+        [[KITAssetOverlayImageCache sharedCache] overlayImageForState:[self overlayState]
+                                                                 size:overlayLayer.bounds.size
+                                                                scale:overlayLayer.contentsScale
+                                                            tintColor:self.tintColor
+                                                       selectionIndex:self.selectionIndex
+                                                           attributes:self.overlayAttributes];
+        
+        overlayLayer.contents = (__bridge id)image.CGImage;
+        overlayLayer.hidden = NO;
+    }
+    else
+    {
+        overlayLayer.contents = nil;
+        overlayLayer.hidden = YES;
+    }
+}
+
+- (KITAssetOverlayState)overlayState
+{
+    KITAssetOverlayState state = KITAssetOverlayStateNone;
+    
+    if (!self.isEnabled)
+        state |= KITAssetOverlayStateDisabled;
+    
+    if (self.isHighlighted)
+        state |= KITAssetOverlayStateHighlighted;
+    
+    if (self.isSelected)
+        state |= KITAssetOverlayStateSelected;
+    
+    if (self.showsSelectionIndex)
+        state |= KITAssetOverlayStateSelectionIndex;
+    
+    return state;
+}
+
+- (void)updateOverlayAttributes
+{
+    self.overlayAttributes = @{KITAssetOverlayDisabledColorAttributeName : self.flatDisabledColor,
+                               KITAssetOverlayHighlightedColorAttributeName : self.flatHighlightedColor};
+}
+
+
+#pragma mark - Bind asset and image
+
+- (void)bind:(id<KITAssetDataSource> )asset
+{
+    [super bind:asset];
+    self.contentView.layer.contents = nil;
+}
+
+- (void)bindImage:(UIImage *)image
+{
+    // layer contents ignore the image orientation, so bake it in for the rare rotated thumbnail
+    if (image && image.imageOrientation != UIImageOrientationUp)
+    {
+        UIGraphicsBeginImageContextWithOptions(image.size, NO, image.scale);
+        [image drawInRect:CGRectMake(0, 0, image.size.width, image.size.height)];
+        image = UIGraphicsGetImageFromCurrentImageContext();
+        UIGraphicsEndImageContext();
+    }
+    
+    CALayer *thumbnailLayer = self.contentView.layer;
+    thumbnailLayer.contents         = (__bridge id)image.CGImage;
+    thumbnailLayer.contentsScale    = (image) ? image.scale : UIScreen.mainScreen.scale;
+}
+
+@end
@@ -0,0 +1,53 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <UIKit/UIKit.h>
+
+
+
+/**
+ *  A draggable thumb on the trailing edge of the grid for jumping through long albums.
+ *
+ *  Sends `UIControlEventTouchDown` when the thumb is grabbed, `UIControlEventValueChanged` while it is dragged
+ *  and `UIControlEventTouchUpInside`, `UIControlEventTouchUpOutside` or `UIControlEventTouchCancel` when it is let go.
+ */
+@interface KITAssetsGridScrubber : UIControl
+
+/**
+ *  The position of the thumb, from 0 (top) to 1 (bottom).
+ */
+@property (nonatomic, assign) CGFloat value;
+
+/**
+ *  The text shown next to the thumb while it is dragged, such as the date of the landing section.
+ */
+@property (nonatomic, copy) NSString *title;
+
+@property (nonatomic, weak) UIFont *font UI_APPEARANCE_SELECTOR;
+@property (nonatomic, weak) UIColor *textColor UI_APPEARANCE_SELECTOR;
+
+@end
@@ -0,0 +1,227 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetsPickerDefines.h"
+#import "KITAssetsGridScrubber.h"
+
+
+
+
+static const CGFloat KITAssetsGridScrubberThumbWidth   = 6.0f;
+static const CGFloat KITAssetsGridScrubberThumbHeight  = 44.0f;
+static const CGFloat KITAssetsGridScrubberThumbMargin  = 4.0f;
+static const CGFloat KITAssetsGridScrubberLabelPadding = 8.0f;
+
+
+
+@interface KITAssetsGridScrubber ()
+
+@property (nonatomic, strong) UIView *thumbView;
+@property (nonatomic, strong) UILabel *label;
+
+@property (nonatomic, assign) CGFloat trackingOffset;
+
+@end
+
+
+
+
+
+@implementation KITAssetsGridScrubber
+
+- (instancetype)initWithFrame:(CGRect)frame
+{
+    if (self = [super initWithFrame:frame])
+    {
+        [self setupViews];
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Setup
+
+- (void)setupViews
+{
+    UIView *thumbView = [UIView new];
+    thumbView.userInteractionEnabled = NO;
+    thumbView.backgroundColor = self.tintColor;
+    thumbView.layer.cornerRadius = KITAssetsGridScrubberThumbWidth / 2;
+    self.thumbView = thumbView;
+    
+    UILabel *label = [UILabel new];
+    label.userInteractionEnabled = NO;
+    label.textAlignment = NSTextAlignmentCenter;
+    label.font = KITAssetsGridScrubberFont;
+    label.textColor = KITAssetsGridScrubberTextColor;
+    label.backgroundColor = self.tintColor;
+    label.layer.cornerRadius = 4;
+    label.layer.masksToBounds = YES;
+    label.hidden = YES;
+    self.label = label;
+    
+    [self addSubview:self.thumbView];
+    [self addSubview:self.label];
+}
+
+
+#pragma mark - Appearance
+
+- (UIFont *)font
+{
+    return self.label.font;
+}
+
+- (void)setFont:(UIFont *)font
+{
+    UIFont *labelFont = (font) ? font : KITAssetsGridScrubberFont;
+    self.label.font = labelFont;
+}
+
+- (UIColor *)textColor
+{
+    return self.label.textColor;
+}
+
+- (void)setTextColor:(UIColor *)textColor
+{
+    UIColor *color = (textColor) ? textColor : KITAssetsGridScrubberTextColor;
+    self.label.textColor = color;
+}
+
+- (void)tintColorDidChange
+{
+    [super tintColorDidChange];
+    
+    self.thumbView.backgroundColor = self.tintColor;
+    self.label.backgroundColor = self.tintColor;
+}
+
+
+#pragma mark - Value
+
+- (void)setValue:(CGFloat)value
+{
+    _value = MIN(MAX(value, 0), 1);
+    [self setNeedsLayout];
+}
+
+- (void)setTitle:(NSString *)title
+{
+    _title = [title copy];
+    self.label.text = title;
+    [self setNeedsLayout];
+}
+
+
+#pragma mark - Layout
+
+- (BOOL)isTrailingEdgeOnLeft
+{
+    return ([UIApplication sharedApplication].userInterfaceLayoutDirection == UIUserInterfaceLayoutDirectionRightToLeft);
+}
+
+- (CGRect)thumbFrame
+{
+    CGFloat travel = MAX(0, CGRectGetHeight(self.bounds) - KITAssetsGridScrubberThumbHeight);
+    CGFloat x = ([self isTrailingEdgeOnLeft]) ? KITAssetsGridScrubberThumbMargin : CGRectGetWidth(self.bounds) - KITAssetsGridScrubberThumbMargin - KITAssetsGridScrubberThumbWidth;
+    
+    return CGRectMake(x, round(self.value * travel), KITAssetsGridScrubberThumbWidth, KITAssetsGridScrubberThumbHeight);
+}
+
+- (void)layoutSubviews
+{
+    [super layoutSubviews];
+    
+    CGRect thumbFrame = [self thumbFrame];
+    self.thumbView.frame = thumbFrame;
+    
+    self.label.hidden = (!self.isTracking || self.title.length == 0);
+    
+    if (!self.label.hidden)
+    {
+        CGSize size = [self.label sizeThatFits:CGSizeZero];
+        size.width  += KITAssetsGridScrubberLabelPadding * 2;
+        size.height += KITAssetsGridScrubberLabelPadding;
+        
+        CGFloat x = ([self isTrailingEdgeOnLeft]) ? CGRectGetMaxX(thumbFrame) + KITAssetsGridScrubberLabelPadding : CGRectGetMinX(thumbFrame) - KITAssetsGridScrubberLabelPadding - size.width;
+        
+        self.label.frame = CGRectMake(x, CGRectGetMidY(thumbFrame) - size.height / 2, size.width, size.height);
+    }
+}
+
+
+#pragma mark - Touches
+
+// only the thumb takes touches, taps anywhere else fall through to the grid
+- (BOOL)pointInside:(CGPoint)point withEvent:(UIEvent *)event
+{
+    if (self.hidden || self.alpha == 0)
+        return NO;
+    
+    CGRect touchFrame = CGRectInset([self thumbFrame], -(CGRectGetWidth(self.bounds) - KITAssetsGridScrubberThumbWidth) / 2, 0);
+    
+    return CGRectContainsPoint(touchFrame, point);
+}
+
+- (BOOL)beginTrackingWithTouch:(UITouch *)touch withEvent:(UIEvent *)event
+{
+    CGPoint point = [touch locationInView:self];
+    self.trackingOffset = point.y - CGRectGetMinY([self thumbFrame]);
+    [self setNeedsLayout];
+    
+    return YES;
+}
+
+- (BOOL)continueTrackingWithTouch:(UITouch *)touch withEvent:(UIEvent *)event
+{
+    CGPoint point = [touch locationInView:self];
+    CGFloat travel = CGRectGetHeight(self.bounds) - KITAssetsGridScrubberThumbHeight;
+    
+    if (travel > 0)
+    {
+        self.value = (point.y - self.trackingOffset) / travel;
+        [self sendActionsForControlEvents:UIControlEventValueChanged];
+    }
+    
+    return YES;
+}
+
+- (void)endTrackingWithTouch:(UITouch *)touch withEvent:(UIEvent *)event
+{
+    [super endTrackingWithTouch:touch withEvent:event];
+    [self setNeedsLayout];
+}
+
+- (void)cancelTrackingWithEvent:(UIEvent *)event
+{
+    [super cancelTrackingWithEvent:event];
+    [self setNeedsLayout];
+}
+
+@end
@@ -0,0 +1,71 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "KITAssetCollectionDataSource.h"
+
+
+
+/**
+ *  Maps the flat index of an asset collection to date sections.
+ *
+ *  Section start indexes are kept as prefix sums, so converting between a flat index and an index path
+ *  is a binary search, and the number of items in a section is a subtraction.
+ */
+@interface KITAssetsGridSectionIndex : NSObject
+
+/**
+ *  Groups consecutive assets created on the same day into sections.
+ *
+ *  Call it on the main thread. Dates are read as `KITAssetMetadataStore` reads them, so asset objects are only
+ *  touched on the main thread; the grouping runs on a background queue and the handler is called on the main queue.
+ *
+ *  @param assetCollection The asset collection.
+ *  @param handler         Handler receiving the section index.
+ */
++ (void)buildSectionIndexForAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+                          completionHandler:(void (^)(KITAssetsGridSectionIndex *sectionIndex))handler;
+
+/**
+ *  Creates a section index from section lengths.
+ *
+ *  @param counts The number of items in each section.
+ *  @param dates  The date of each section, with `NSNull` for sections without one.
+ */
+- (instancetype)initWithSectionCounts:(NSArray<NSNumber *> *)counts dates:(NSArray *)dates;
+
+@property (nonatomic, assign, readonly) NSInteger numberOfSections;
+@property (nonatomic, assign, readonly) NSUInteger numberOfItems;
+
+- (NSInteger)numberOfItemsInSection:(NSInteger)section;
+- (NSDate *)dateForSection:(NSInteger)section;
+
+- (NSUInteger)indexForIndexPath:(NSIndexPath *)indexPath;
+- (NSIndexPath *)indexPathForIndex:(NSUInteger)index;
+- (NSInteger)sectionForIndex:(NSUInteger)index;
+
+@end
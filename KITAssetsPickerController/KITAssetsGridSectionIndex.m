@@ -0,0 +1,222 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <UIKit/UIKit.h>
+#import "KITAssetsGridSectionIndex.h"
+#import "KITAssetMetadataStore.h"
+
+
+
+
+@interface KITAssetsGridSectionIndex ()
+
+@property (nonatomic, assign, readwrite) NSInteger numberOfSections;
+@property (nonatomic, assign, readwrite) NSUInteger numberOfItems;
+
+// offsets[section] is the flat index of the first item; offsets[numberOfSections] is the item count
+@property (nonatomic, assign) NSUInteger *offsets;
+@property (nonatomic, copy) NSArray *dates;
+
+@end
+
+
+
+
+
+@implementation KITAssetsGridSectionIndex
+
++ (void)buildSectionIndexForAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+                          completionHandler:(void (^)(KITAssetsGridSectionIndex *sectionIndex))handler
+{
+    // the store reads asset objects on the main thread only, and skips them for bulk metadata
+    [KITAssetMetadataStore buildMetadataStoreForAssetCollection:assetCollection completionHandler:^(KITAssetMetadataStore *metadataStore) {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
+            const NSTimeInterval *creationDates = metadataStore.columns.creationDates;
+            
+            KITAssetsGridSectionIndex *sectionIndex =
+            [self sectionIndexWithCount:metadataStore.count creationDateAtIndex:^NSTimeInterval(NSUInteger index) {
+                return creationDates[index];
+            }];
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                handler(sectionIndex);
+            });
+        });
+    }];
+}
+
++ (instancetype)sectionIndexWithCount:(NSUInteger)count creationDateAtIndex:(NSTimeInterval (^)(NSUInteger index))creationDateAtIndex
+{
+    NSCalendar *calendar = [NSCalendar currentCalendar];
+    
+    NSTimeInterval dayStart = NAN;
+    NSTimeInterval dayEnd = NAN;
+    
+    NSMutableArray *counts = [NSMutableArray new];
+    NSMutableArray *dates = [NSMutableArray new];
+    
+    NSDate *sectionDay = nil;
+    NSTimeInterval sectionDayStart = NAN;
+    NSUInteger sectionCount = 0;
+    
+    for (NSUInteger index = 0; index < count; index++)
+    {
+        NSTimeInterval time = creationDateAtIndex(index);
+        
+        // the calendar is only asked when an asset falls outside the current day
+        if (!isnan(time) && !(time >= dayStart && time < dayEnd))
+        {
+            NSDate *start = nil;
+            NSTimeInterval length = 0;
+            
+            [calendar rangeOfUnit:NSCalendarUnitDay
+                        startDate:&start
+                         interval:&length
+                          forDate:[NSDate dateWithTimeIntervalSinceReferenceDate:time]];
+            
+            dayStart = start.timeIntervalSinceReferenceDate;
+            dayEnd = dayStart + length;
+        }
+        
+        // undated assets join the section before them
+        if (sectionCount > 0 && (isnan(time) || dayStart == sectionDayStart))
+        {
+            sectionCount++;
+            continue;
+        }
+        
+        if (sectionCount > 0)
+        {
+            [counts addObject:@(sectionCount)];
+            [dates addObject:(sectionDay) ? sectionDay : [NSNull null]];
+        }
+        
+        sectionDayStart = (!isnan(time)) ? dayStart : NAN;
+        sectionDay = (!isnan(time)) ? [NSDate dateWithTimeIntervalSinceReferenceDate:dayStart] : nil;
+        sectionCount = 1;
+    }
+    
+    if (sectionCount > 0)
+    {
+        [counts addObject:@(sectionCount)];
+        [dates addObject:(sectionDay) ? sectionDay : [NSNull null]];
+    }
+    
+    return [[self alloc] initWithSectionCounts:counts dates:dates];
+}
+
+- (instancetype)initWithSectionCounts:(NSArray<NSNumber *> *)counts dates:(NSArray *)dates
+{
+    if (self = [super init])
+    {
+        NSInteger numberOfSections = counts.count;
+        NSUInteger *offsets = malloc((numberOfSections + 1) * sizeof(NSUInteger));
+        
+        offsets[0] = 0;
+        
+        for (NSInteger section = 0; section < numberOfSections; section++)
+            offsets[section + 1] = offsets[section] + counts[section].unsignedIntegerValue;
+        
+        _offsets = offsets;
+        _numberOfSections = numberOfSections;
+        _numberOfItems = offsets[numberOfSections];
+        _dates = [dates copy];
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_offsets);
+}
+
+
+#pragma mark - Sections
+
+- (NSInteger)numberOfItemsInSection:(NSInteger)section
+{
+    if (section < 0 || section >= self.numberOfSections)
+        return 0;
+    
+    return self.offsets[section + 1] - self.offsets[section];
+}
+
+- (NSDate *)dateForSection:(NSInteger)section
+{
+    if (section < 0 || section >= (NSInteger)self.dates.count)
+        return nil;
+    
+    id date = self.dates[section];
+    
+    return ([date isKindOfClass:NSDate.class]) ? date : nil;
+}
+
+
+#pragma mark - Index mapping
+
+- (NSInteger)sectionForIndex:(NSUInteger)index
+{
+    if (self.numberOfSections == 0)
+        return NSNotFound;
+    
+    // last section whose first index is not past the index
+    NSInteger low = 0;
+    NSInteger high = self.numberOfSections - 1;
+    
+    while (low < high)
+    {
+        NSInteger mid = (low + high + 1) / 2;
+        
+        if (self.offsets[mid] <= index)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+    
+    return low;
+}
+
+- (NSUInteger)indexForIndexPath:(NSIndexPath *)indexPath
+{
+    if (indexPath.section >= self.numberOfSections)
+        return NSNotFound;
+    
+    return self.offsets[indexPath.section] + indexPath.item;
+}
+
+- (NSIndexPath *)indexPathForIndex:(NSUInteger)index
+{
+    if (index >= self.numberOfItems)
+        return nil;
+    
+    NSInteger section = [self sectionForIndex:index];
+    
+    return [NSIndexPath indexPathForItem:index - self.offsets[section] inSection:section];
+}
+
+@end
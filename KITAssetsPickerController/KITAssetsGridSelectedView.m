@@ -24,20 +24,20 @@
  
  */
 
-#import <PureLayout/PureLayout.h>
 #import "KITAssetsPickerDefines.h"
 #import "KITAssetsGridSelectedView.h"
-#import "KITAssetCheckmark.h"
+#import "KITAssetOverlayImageCache.h"
 
 
 
 
 @interface KITAssetsGridSelectedView ()
 
-@property (nonatomic, strong) KITAssetCheckmark *checkmark;
-@property (nonatomic, strong) UILabel *selectionIndexLabel;
+@property (nonatomic, strong) UIImageView *badgeView;
 
-@property (nonatomic, assign) BOOL didSetupConstraints;
+@property (nonatomic, strong) UIFont *badgeFont;
+@property (nonatomic, strong) UIColor *badgeTextColor;
+@property (nonatomic, copy) NSDictionary *badgeAttributes;
 
 @end
 
@@ -66,18 +66,12 @@
     self.backgroundColor = KITAssetsGridSelectedViewBackgroundColor;
     self.layer.borderColor = KITAssetsGridSelectedViewTintColor.CGColor;
     
-    KITAssetCheckmark *checkmark = [KITAssetCheckmark newAutoLayoutView];
-    self.checkmark = checkmark;
-    [self addSubview:checkmark];
+    // the checkmark or the selection index, pre-rendered and shared by every cell
+    UIImageView *badgeView = [UIImageView new];
+    badgeView.userInteractionEnabled = NO;
+    self.badgeView = badgeView;
     
-    UILabel *selectionIndexLabel = [UILabel newAutoLayoutView];
-    selectionIndexLabel.textAlignment = NSTextAlignmentCenter;
-    selectionIndexLabel.backgroundColor = self.tintColor;
-    selectionIndexLabel.font = KITAssetsGridSelectedViewFont;
-    selectionIndexLabel.textColor = KITAssetsGridSelectedViewTextColor;
-    self.selectionIndexLabel = selectionIndexLabel;
-    
-    [self addSubview:self.selectionIndexLabel];
+    [self addSubview:self.badgeView];
 }
 
 
@@ -96,24 +90,25 @@
 
 - (UIFont *)font
 {
-    return self.selectionIndexLabel.font;
+    return (self.badgeFont) ? self.badgeFont : KITAssetsGridSelectedViewFont;
 }
 
 - (void)setFont:(UIFont *)font
 {
-    UIFont *labelFont = (font) ? font : KITAssetsGridSelectedViewFont;
-    self.selectionIndexLabel.font = labelFont;
+    // nil keeps following Dynamic Type, resolved when the badge is rendered
+    self.badgeFont = font;
+    [self updateBadgeAttributes];
 }
 
 - (UIColor *)textColor
 {
-    return self.selectionIndexLabel.textColor;
+    return (self.badgeTextColor) ? self.badgeTextColor : KITAssetsGridSelectedViewTextColor;
 }
 
 - (void)setTextColor:(UIColor *)textColor
 {
-    UIColor *color = (textColor) ? textColor : KITAssetsGridSelectedViewTextColor;
-    self.selectionIndexLabel.textColor = color;
+    self.badgeTextColor = textColor;
+    [self updateBadgeAttributes];
 }
 
 - (CGFloat)borderWidth
@@ -128,59 +123,90 @@
 
 - (void)setTintColor:(UIColor *)tintColor
 {
+    // nil keeps following the inherited tint, resolved when the badge is rendered
+    [super setTintColor:tintColor];
+    
     UIColor *color = (tintColor) ? tintColor : KITAssetsGridSelectedViewTintColor;
-    self.selectionIndexLabel.backgroundColor = color;
     self.layer.borderColor = color.CGColor;
 }
 
+- (void)tintColorDidChange
+{
+    [super tintColorDidChange];
+    [self updateBadge];
+}
+
+- (void)updateBadgeAttributes
+{
+    NSMutableDictionary *attributes = [NSMutableDictionary new];
+    
+    if (self.badgeFont)
+        attributes[KITAssetOverlayFontAttributeName] = self.badgeFont;
+    
+    if (self.badgeTextColor)
+        attributes[KITAssetOverlayTextColorAttributeName] = self.badgeTextColor;
+    
+    self.badgeAttributes = (attributes.count > 0) ? attributes : nil;
+    [self updateBadge];
+}
+
 
 #pragma mark - Accessors
 
 - (void)setShowsSelectionIndex:(BOOL)showsSelectionIndex
 {
     _showsSelectionIndex = showsSelectionIndex;
-    
-    if (showsSelectionIndex)
-    {
-        self.checkmark.hidden = YES;
-        self.selectionIndexLabel.hidden = NO;
-    }
-    else
-    {
-        self.checkmark.hidden = NO;
-        self.selectionIndexLabel.hidden = YES;
-    }
+    [self updateBadge];
 }
 
 - (void)setSelectionIndex:(NSUInteger)selectionIndex;
 {
     _selectionIndex = selectionIndex;
-    self.selectionIndexLabel.text = [NSString stringWithFormat:@"%lu", (unsigned long)(selectionIndex + 1)];
+    
+    if (self.showsSelectionIndex)
+        [self updateBadge];
 }
 
 
-#pragma mark - Update auto layout constraints
+#pragma mark - Badge
 
-- (void)updateConstraints
+- (void)updateBadge
 {
-    if (!self.didSetupConstraints)
+    KITAssetOverlayState state = KITAssetOverlayStateSelected;
+    
+    if (self.showsSelectionIndex)
+        state |= KITAssetOverlayStateSelectionIndex;
+    
+    CGFloat scale = (self.window) ? self.window.screen.scale : UIScreen.mainScreen.scale;
+    
+    UIImage *image =
+    [[KITAssetOverlayImageCache sharedCache] overlayImageForState:state
+                                                             size:CGSizeZero
+                                                            scale:scale
+                                                        tintColor:self.tintColor
+                                                   selectionIndex:self.selectionIndex
+                                                       attributes:self.badgeAttributes];
+    
+    if (self.badgeView.image != image)
     {
-        [NSLayoutConstraint autoSetPriority:UILayoutPriorityRequired forConstraints:^{
-            CGFloat height = self.selectionIndexLabel.font.pointSize + 8;
-            [self.selectionIndexLabel autoSetDimension:ALDimensionHeight toSize:height];
-            [self.selectionIndexLabel autoConstrainAttribute:ALAttributeWidth toAttribute:ALAttributeHeight ofView:self.selectionIndexLabel];
-        }];
-        
-        [self.selectionIndexLabel autoPinEdgeToSuperviewEdge:ALEdgeTop withInset:0];
-        [self.selectionIndexLabel autoPinEdgeToSuperviewEdge:ALEdgeRight withInset:0];
-        
-        [self.checkmark autoPinEdgeToSuperviewEdge:ALEdgeBottom withInset:0];
-        [self.checkmark autoPinEdgeToSuperviewEdge:ALEdgeRight withInset:0];
-        
-        self.didSetupConstraints = YES;
+        self.badgeView.image = image;
+        [self setNeedsLayout];
     }
+}
+
+
+#pragma mark - Layout
+
+- (void)layoutSubviews
+{
+    [super layoutSubviews];
+    
+    CGRect bounds   = self.bounds;
+    CGSize size     = self.badgeView.image.size;
     
-    [super updateConstraints];
+    // the selection index sits at the top, the checkmark at the bottom
+    CGFloat y = (self.showsSelectionIndex) ? 0 : CGRectGetHeight(bounds) - size.height;
+    self.badgeView.frame = CGRectMake(CGRectGetWidth(bounds) - size.width, y, size.width, size.height);
 }
 
 
@@ -188,7 +214,10 @@
 
 - (NSString *)accessibilityLabel
 {
-    return self.selectionIndexLabel.text;
+    if (!self.showsSelectionIndex)
+        return nil;
+    
+    return [NSString stringWithFormat:@"%lu", (unsigned long)(self.selectionIndex + 1)];
 }
 
 
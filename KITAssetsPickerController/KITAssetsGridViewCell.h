@@ -35,9 +35,12 @@
 @property (nonatomic, assign) BOOL showsSelectionIndex;
 @property (nonatomic, assign) NSUInteger selectionIndex;
 
+@property (nonatomic, strong, readonly) id<KITAssetDataSource> asset;
+
 @property (nonatomic, weak) UIColor *disabledColor UI_APPEARANCE_SELECTOR;
 @property (nonatomic, weak) UIColor *highlightedColor UI_APPEARANCE_SELECTOR;
 
 - (void)bind:(id<KITAssetDataSource> )asset;
+- (void)bindImage:(UIImage *)image;
 
 @end
\ No newline at end of file
@@ -24,7 +24,6 @@
  
  */
 
-#import <PureLayout/PureLayout.h>
 #import "KITAssetsPickerDefines.h"
 #import "KITAssetsGridViewCell.h"
 #import "KITAssetsGridSelectedView.h"
@@ -42,8 +41,6 @@
 @property (nonatomic, strong) UIView *highlightedView;
 @property (nonatomic, strong) KITAssetsGridSelectedView *selectedView;
 
-@property (nonatomic, assign) BOOL didSetupConstraints;
-
 @end
 
 
@@ -73,7 +70,7 @@
 
 - (void)setupViews
 {
-    KITAssetThumbnailView *thumbnailView = [KITAssetThumbnailView newAutoLayoutView];
+    KITAssetThumbnailView *thumbnailView = [KITAssetThumbnailView new];
     self.backgroundView = thumbnailView;
     
     UIImage *disabledImage = [UIImage KITAssetsPickerImageNamed:@"GridDisabledAsset"];
@@ -82,20 +79,20 @@
     disabledImageView.tintColor = KITAssetsPikcerThumbnailTintColor;
     self.disabledImageView = disabledImageView;
     
-    UIView *disabledView = [UIView newAutoLayoutView];
+    UIView *disabledView = [UIView new];
     disabledView.backgroundColor = KITAssetsGridViewCellDisabledColor;
     disabledView.hidden = YES;
     [disabledView addSubview:self.disabledImageView];
     self.disabledView = disabledView;
     [self addSubview:self.disabledView];
     
-    UIView *highlightedView = [UIView newAutoLayoutView];
+    UIView *highlightedView = [UIView new];
     highlightedView.backgroundColor = KITAssetsGridViewCellHighlightedColor;
     highlightedView.hidden = YES;
     self.highlightedView = highlightedView;
     [self addSubview:self.highlightedView];
     
-    KITAssetsGridSelectedView *selectedView = [KITAssetsGridSelectedView newAutoLayoutView];
+    KITAssetsGridSelectedView *selectedView = [KITAssetsGridSelectedView new];
     selectedView.hidden = YES;
     self.selectedView = selectedView;
     [self addSubview:self.selectedView];
@@ -159,34 +156,31 @@
 }
 
 
-#pragma mark - Update auto layout constraints
+#pragma mark - Layout
 
-- (void)updateConstraints
+// The geometry never changes between binds, so plain frames keep the Auto Layout engine out of scrolling.
+- (void)layoutSubviews
 {
-    if (!self.didSetupConstraints)
-    {
-        [NSLayoutConstraint autoSetPriority:UILayoutPriorityRequired forConstraints:^{
-            [self.backgroundView autoPinEdgesToSuperviewEdgesWithInsets:UIEdgeInsetsZero];
-            [self.disabledView autoPinEdgesToSuperviewEdgesWithInsets:UIEdgeInsetsZero];
-            [self.highlightedView autoPinEdgesToSuperviewEdgesWithInsets:UIEdgeInsetsZero];
-            [self.selectedView autoPinEdgesToSuperviewEdgesWithInsets:UIEdgeInsetsZero];
-        }];
-        
-        [self.disabledImageView autoCenterInSuperview];
-
-        self.didSetupConstraints = YES;
-    }
+    [super layoutSubviews];
     
-    [super updateConstraints];
+    CGRect bounds = self.bounds;
+    
+    self.disabledView.frame         = bounds;
+    self.highlightedView.frame      = bounds;
+    self.selectedView.frame         = bounds;
+    self.disabledImageView.center   = CGPointMake(CGRectGetMidX(bounds) - CGRectGetMinX(bounds),
+                                                  CGRectGetMidY(bounds) - CGRectGetMinY(bounds));
 }
 
 
 - (void)bind:(id<KITAssetDataSource> )asset
 {
     self.asset = asset;
-    
-    [self setNeedsUpdateConstraints];
-    [self updateConstraintsIfNeeded];
+}
+
+- (void)bindImage:(UIImage *)image
+{
+    [(KITAssetThumbnailView *)self.backgroundView bind:image asset:self.asset];
 }
 
 @end
\ No newline at end of file
@@ -30,8 +30,19 @@
 #import "KITAssetsGridViewController.h"
 #import "KITAssetsGridView.h"
 #import "KITAssetsGridViewLayout.h"
+#import "KITAssetsGridViewLayoutGeometry.h"
 #import "KITAssetsGridViewCell.h"
+#import "KITAssetsGridFlatViewCell.h"
 #import "KITAssetsGridViewFooter.h"
+#import "KITAssetsGridViewSectionHeader.h"
+#import "KITAssetsGridSectionIndex.h"
+#import "KITAsyncAssetCollectionDataSource.h"
+#import "KITAssetIndexMap.h"
+#import "KITAssetCollectionChangeSet.h"
+#import "KITAssetsGridScrubber.h"
+#import "KITAssetThumbnailGenerator.h"
+#import "KITAssetOverlayImageCache.h"
+#import "KITAssetsPickerPrewarmer.h"
 #import "KITAssetsPickerNoAssetsView.h"
 #import "KITAssetsPageViewController.h"
 #import "KITAssetsPageViewController+Internal.h"
@@ -44,7 +55,9 @@
 
 
 NSString * const KITAssetsGridViewCellIdentifier = @"KITAssetsGridViewCellIdentifier";
+NSString * const KITAssetsGridFlatViewCellIdentifier = @"KITAssetsGridFlatViewCellIdentifier";
 NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterIdentifier";
+NSString * const KITAssetsGridViewSectionHeaderIdentifier = @"KITAssetsGridViewSectionHeaderIdentifier";
 
 
 @interface KITAssetsGridViewController ()
@@ -52,12 +65,35 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
 @property (nonatomic, weak) KITAssetsPickerController *picker;
 
 @property (nonatomic, assign) CGRect previousPreheatRect;
+@property (nonatomic, copy) NSArray *assetWindow;
+@property (nonatomic, assign) NSRange assetWindowRange;
+
+@property (nonatomic, strong) KITAssetIndexMap *assetIndexMap;
+@property (nonatomic, strong) NSMutableIndexSet *loadingIndexes;
+@property (nonatomic, assign, getter=isLoadingMoreAssets) BOOL loadingMoreAssets;
 @property (nonatomic, assign) CGRect previousBounds;
 
 @property (nonatomic, strong) KITAssetsGridViewFooter *footer;
 @property (nonatomic, strong) KITAssetsPickerNoAssetsView *noAssetsView;
 
+@property (nonatomic, strong) KITAssetsGridSectionIndex *sectionIndex;
+@property (nonatomic, assign, getter=isBuildingSectionIndex) BOOL buildingSectionIndex;
+
 @property (nonatomic, assign) BOOL didLayoutSubviews;
+@property (nonatomic, assign) BOOL didBindFirstThumbnail;
+@property (nonatomic, assign, getter=isSignpostingOpen) BOOL signpostingOpen;
+
+@property (nonatomic, assign) NSInteger numberOfColumns;
+@property (nonatomic, strong) NSCache *gridLayouts;
+@property (nonatomic, strong) NSMapTable *thumbnailTargetSizes;
+
+@property (nonatomic, strong) KITAssetsGridScrubber *scrubber;
+@property (nonatomic, assign, getter=isScrubbing) BOOL scrubbing;
+
+@property (nonatomic, strong) UICollectionViewTransitionLayout *transitionLayout;
+@property (nonatomic, assign) NSInteger transitionNumberOfColumns;
+@property (nonatomic, assign) BOOL didPrewarmCells;
+@property (nonatomic, assign, getter=isPrewarmingCells) BOOL prewarmingCells;
 
 @end
 
@@ -71,6 +107,7 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
 - (instancetype)init
 {
     KITAssetsGridViewLayout *layout = [KITAssetsGridViewLayout new];
+    layout.showsFooterInLastSectionOnly = YES;
     
     if (self = [super initWithCollectionViewLayout:layout])
     {
@@ -81,10 +118,17 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
         [self.collectionView registerClass:KITAssetsGridViewCell.class
                 forCellWithReuseIdentifier:KITAssetsGridViewCellIdentifier];
         
+        [self.collectionView registerClass:KITAssetsGridFlatViewCell.class
+                forCellWithReuseIdentifier:KITAssetsGridFlatViewCellIdentifier];
+        
         [self.collectionView registerClass:KITAssetsGridViewFooter.class
                 forSupplementaryViewOfKind:UICollectionElementKindSectionFooter
                        withReuseIdentifier:KITAssetsGridViewFooterIdentifier];
         
+        [self.collectionView registerClass:KITAssetsGridViewSectionHeader.class
+                forSupplementaryViewOfKind:UICollectionElementKindSectionHeader
+                       withReuseIdentifier:KITAssetsGridViewSectionHeaderIdentifier];
+        
         [self addNotificationObserver];
     }
     
@@ -96,43 +140,64 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
     [super viewDidLoad];
     [self setupViews];
     [self addGestureRecognizer];
-    [self addNotificationObserver];
     [self resetCachedAssetImages];
 }
 
 - (void)viewWillAppear:(BOOL)animated
 {
     [super viewWillAppear:animated];
+    
+    // open to first thumbnail, see Points of Interest
+    if (!self.didBindFirstThumbnail && !self.isSignpostingOpen)
+    {
+        self.signpostingOpen = YES;
+        [KITAssetsPickerPrewarmer signpostStart:KITAssetsPickerOpenGridSignpostCode];
+    }
+    
     [self setupAssets];
     [self setupButtons];
+    
+    // no thumbnail is coming for an empty collection
+    if (self.assetCollection.count == 0 && !self.isLoadingMoreAssets)
+        [self endOpenSignpost];
+}
+
+- (void)viewWillDisappear:(BOOL)animated
+{
+    [super viewWillDisappear:animated];
+    [self endOpenSignpost];
 }
 
 - (void)viewDidAppear:(BOOL)animated
 {
     [super viewDidAppear:animated];
     [self updateCachedAssetImages];
+    [self prewarmCellsWhenIdle];
 }
 
 - (void)viewWillLayoutSubviews
 {
     [super viewWillLayoutSubviews];
     
-    if (!CGRectEqualToRect(self.view.bounds, self.previousBounds))
+    // the origin moves on every scroll, only a new size needs a new layout
+    if (!self.isPrewarmingCells && !CGSizeEqualToSize(self.view.bounds.size, self.previousBounds.size))
     {
         [self updateCollectionViewLayout];
         self.previousBounds = self.view.bounds;
     }
+    
+    // before the collection view lays out, so the first cells it builds are the bottom ones
+    if ([self.collectionViewLayout isKindOfClass:KITAssetsGridViewLayout.class] && CGRectGetHeight(self.view.bounds) > 0)
+        [self scrollToBottomOnceIfNeeded];
 }
 
 - (void)viewDidLayoutSubviews
 {
     [super viewDidLayoutSubviews];
     
-    if (!self.didLayoutSubviews && self.assetCollection.count > 0)
-    {
-        [self scrollToBottomIfNeeded];
-        self.didLayoutSubviews = YES;
-    }
+    // layouts from the delegate can only be scrolled once laid out
+    [self scrollToBottomOnceIfNeeded];
+    [self layoutScrubber];
 }
 
 - (void)updateButton:(NSArray *)selectedAssets
@@ -155,7 +220,233 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
 
 - (id<KITAssetDataSource> )assetAtIndexPath:(NSIndexPath *)indexPath
 {
-    return (self.assetCollection.count > 0) ? [self.assetCollection objectAtIndex:indexPath.item] : nil;
+    NSUInteger index = [self assetIndexForIndexPath:indexPath];
+    
+    if (index >= self.assetCollection.count || ![self isAssetLoadedAtIndex:index])
+        return nil;
+    
+    // cells are served from the window fetched in one batch; fill it on the first miss
+    if (!NSLocationInRange(index, self.assetWindowRange))
+        [self updateAssetWindowForRect:[self preheatRect]];
+    
+    if (NSLocationInRange(index, self.assetWindowRange))
+        return self.assetWindow[index - self.assetWindowRange.location];
+    
+    return [self.assetCollection objectAtIndex:index];
+}
+
+- (void)setAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+{
+    _assetCollection = assetCollection;
+    self.sectionIndex = nil;
+    self.assetIndexMap = [[KITAssetIndexMap alloc] initWithAssetCollection:assetCollection];
+    self.loadingIndexes = [NSMutableIndexSet new];
+    self.loadingMoreAssets = NO;
+    [self resetAssetWindow];
+}
+
+- (id<KITAsyncAssetCollectionDataSource>)asyncAssetCollection
+{
+    if ([self.assetCollection conformsToProtocol:@protocol(KITAsyncAssetCollectionDataSource)])
+        return (id<KITAsyncAssetCollectionDataSource>)self.assetCollection;
+    else
+        return nil;
+}
+
+
+#pragma mark - Paged collections
+
+- (BOOL)isAssetLoadedAtIndex:(NSUInteger)index
+{
+    id<KITAsyncAssetCollectionDataSource> collection = [self asyncAssetCollection];
+    return (!collection || [collection areObjectsLoadedInRange:NSMakeRange(index, 1)]);
+}
+
+// Asks for the pages of a rect that are not loaded, and for the next page once the rect reaches the end
+- (void)loadAssetsInRectIfNeeded:(CGRect)rect
+{
+    id<KITAsyncAssetCollectionDataSource> collection = [self asyncAssetCollection];
+    
+    if (!collection)
+        return;
+    
+    NSRange range = [self assetRangeForRect:rect];
+    
+    if (range.location != NSNotFound && ![collection areObjectsLoadedInRange:range] && ![self.loadingIndexes intersectsIndexesInRange:range])
+    {
+        [self.loadingIndexes addIndexesInRange:range];
+        
+        __weak KITAssetsGridViewController *weakSelf = self;
+        
+        [collection loadObjectsInRange:range completionHandler:^(NSError *error) {
+            [weakSelf didLoadAssetsInRange:range ofCollection:collection];
+        }];
+    }
+    
+    BOOL reachesEnd = (range.location == NSNotFound || NSMaxRange(range) >= collection.count);
+    
+    if (reachesEnd)
+        [self loadMoreAssetsIfNeeded];
+}
+
+- (void)didLoadAssetsInRange:(NSRange)range ofCollection:(id<KITAsyncAssetCollectionDataSource>)collection
+{
+    if (collection != self.assetCollection)
+        return;
+    
+    [self.loadingIndexes removeIndexesInRange:range];
+    [self resetAssetWindow];
+    [self.picker assetCollectionDidLoadAssets:collection];
+    
+    // only the visible placeholders are refreshed
+    NSMutableArray *indexPaths = [NSMutableArray new];
+    
+    for (NSIndexPath *indexPath in [self.collectionView indexPathsForVisibleItems])
+    {
+        if (NSLocationInRange([self assetIndexForIndexPath:indexPath], range))
+            [indexPaths addObject:indexPath];
+    }
+    
+    if (indexPaths.count > 0)
+        [self.collectionView reloadItemsAtIndexPaths:indexPaths];
+    
+    [self buildSectionIndexIfNeeded];
+}
+
+- (void)loadMoreAssetsIfNeeded
+{
+    id<KITAsyncAssetCollectionDataSource> collection = [self asyncAssetCollection];
+    
+    if (!collection || self.isLoadingMoreAssets || ![collection hasMoreObjects])
+        return;
+    
+    self.loadingMoreAssets = YES;
+    
+    __weak KITAssetsGridViewController *weakSelf = self;
+    
+    [collection loadMoreObjectsWithCompletionHandler:^(NSUInteger numberOfNewObjects, NSError *error) {
+        [weakSelf didLoadMoreAssets:numberOfNewObjects ofCollection:collection];
+    }];
+}
+
+- (void)didLoadMoreAssets:(NSUInteger)numberOfNewObjects ofCollection:(id<KITAsyncAssetCollectionDataSource>)collection
+{
+    if (collection != self.assetCollection)
+        return;
+    
+    self.loadingMoreAssets = NO;
+    
+    if (numberOfNewObjects == 0)
+    {
+        [self reloadData];
+        [self buildSectionIndexIfNeeded];
+        
+        if (collection.count == 0)
+            [self endOpenSignpost];
+        
+        return;
+    }
+    
+    NSUInteger count = collection.count;
+    NSRange range = NSMakeRange(count - numberOfNewObjects, numberOfNewObjects);
+    
+    KITAssetCollectionChangeSet *changeSet =
+    [[KITAssetCollectionChangeSet alloc] initWithRemovedIndexes:nil
+                                                insertedIndexes:[NSIndexSet indexSetWithIndexesInRange:range]
+                                                 changedIndexes:nil
+                                                          moves:nil];
+    
+    [self.picker assetCollectionDidLoadAssets:collection];
+    [self applyChangeSet:changeSet keepsBottomVisible:NO];
+    [self buildSectionIndexIfNeeded];
+}
+
+
+#pragma mark - Sections
+
+- (NSUInteger)assetIndexForIndexPath:(NSIndexPath *)indexPath
+{
+    return (self.sectionIndex) ? [self.sectionIndex indexForIndexPath:indexPath] : indexPath.item;
+}
+
+- (NSIndexPath *)indexPathForAssetIndex:(NSUInteger)index
+{
+    if (index == NSNotFound || index >= self.assetCollection.count)
+        return nil;
+    
+    return (self.sectionIndex) ? [self.sectionIndex indexPathForIndex:index] : [NSIndexPath indexPathForItem:index inSection:0];
+}
+
+- (NSIndexPath *)indexPathForAsset:(id<KITAssetDataSource>)asset
+{
+    return [self indexPathForAssetIndex:[self.assetIndexMap indexOfAsset:asset]];
+}
+
+- (void)buildSectionIndexIfNeeded
+{
+    NSUInteger count = self.assetCollection.count;
+    
+    if (!self.picker.groupsAssetsByDate || self.sectionIndex || self.isBuildingSectionIndex || count == 0)
+        return;
+    
+    // dates of pages not loaded yet are unknown, so a paged album is grouped once all of it is in
+    id<KITAsyncAssetCollectionDataSource> asyncCollection = [self asyncAssetCollection];
+    
+    if (asyncCollection && ([asyncCollection hasMoreObjects] || ![asyncCollection areObjectsLoadedInRange:NSMakeRange(0, count)]))
+        return;
+    
+    self.buildingSectionIndex = YES;
+    
+    id<KITAssetCollectionDataSource> assetCollection = self.assetCollection;
+    __weak KITAssetsGridViewController *weakSelf = self;
+    
+    [KITAssetsGridSectionIndex buildSectionIndexForAssetCollection:assetCollection completionHandler:^(KITAssetsGridSectionIndex *sectionIndex) {
+        weakSelf.buildingSectionIndex = NO;
+        
+        // the album changed while grouping
+        if (weakSelf.assetCollection != assetCollection || sectionIndex.numberOfItems != assetCollection.count)
+            return;
+        
+        [weakSelf applySectionIndex:sectionIndex];
+    }];
+}
+
+- (void)applySectionIndex:(KITAssetsGridSectionIndex *)sectionIndex
+{
+    UICollectionView *collectionView = self.collectionView;
+    
+    // keep the same assets on screen across the reload
+    CGFloat maxOffsetY = collectionView.contentSize.height - CGRectGetHeight(collectionView.bounds) + collectionView.contentInset.bottom;
+    BOOL isAtBottom = (collectionView.contentOffset.y >= maxOffsetY - 1);
+    
+    NSIndexPath *anchorIndexPath = [[collectionView.indexPathsForVisibleItems sortedArrayUsingSelector:@selector(compare:)] firstObject];
+    NSUInteger anchorIndex = (anchorIndexPath) ? [self assetIndexForIndexPath:anchorIndexPath] : NSNotFound;
+    
+    self.sectionIndex = sectionIndex;
+    [self updateLayoutSections:self.collectionViewLayout];
+    [self reloadData];
+    [collectionView layoutIfNeeded];
+    
+    if (isAtBottom && self.didLayoutSubviews)
+        [self scrollToBottomIfNeeded];
+    else if (anchorIndex != NSNotFound)
+        [collectionView scrollToItemAtIndexPath:[self indexPathForAssetIndex:anchorIndex]
+                               atScrollPosition:UICollectionViewScrollPositionTop
+                                       animated:NO];
+}
+
+- (void)updateLayoutSections:(UICollectionViewLayout *)layout
+{
+    if (![layout isKindOfClass:KITAssetsGridViewLayout.class])
+        return;
+    
+    KITAssetsGridViewLayout *gridLayout = (KITAssetsGridViewLayout *)layout;
+    CGFloat width = CGRectGetWidth(self.view.bounds);
+    
+    gridLayout.showsFooterInLastSectionOnly = YES;
+    gridLayout.headerReferenceSize = (self.sectionIndex) ? CGSizeMake(width, KITAssetsGridViewSectionHeaderHeight) : CGSizeZero;
+    
+    [gridLayout invalidateLayout];
 }
 
 
@@ -167,6 +458,16 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
     KITAssetsGridView *gridView = [KITAssetsGridView new];
     [self.view insertSubview:gridView atIndex:0];
     [self.view setNeedsUpdateConstraints];
+    
+    KITAssetsGridScrubber *scrubber = [KITAssetsGridScrubber new];
+    scrubber.hidden = YES;
+    
+    [scrubber addTarget:self action:@selector(scrubberDidBegin:) forControlEvents:UIControlEventTouchDown];
+    [scrubber addTarget:self action:@selector(scrubberValueChanged:) forControlEvents:UIControlEventValueChanged];
+    [scrubber addTarget:self action:@selector(scrubberDidEnd:) forControlEvents:UIControlEventTouchUpInside | UIControlEventTouchUpOutside | UIControlEventTouchCancel];
+    
+    self.scrubber = scrubber;
+    [self.view addSubview:self.scrubber];
 }
 
 - (void)setupButtons
@@ -190,6 +491,10 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
 - (void)setupAssets
 {
     [self reloadData];
+    [self buildSectionIndexIfNeeded];
+    
+    if (self.assetCollection.count == 0)
+        [self loadMoreAssetsIfNeeded];
 }
 
 
@@ -207,21 +512,164 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
         if ([self.picker.delegate respondsToSelector:@selector(assetsPickerController:collectionViewLayoutForContentSize:traitCollection:)]) {
             layout = [self.picker.delegate assetsPickerController:self.picker collectionViewLayoutForContentSize:contentSize traitCollection:trait];
         } else {
-            layout = [[KITAssetsGridViewLayout alloc] initWithContentSize:contentSize traitCollection:trait];
+            layout = [self gridLayoutWithNumberOfColumns:[self currentNumberOfColumns]];
         }
         
+        // e.g. only the height changed
+        if (layout == self.collectionView.collectionViewLayout)
+            return;
+        
         __weak KITAssetsGridViewController *weakSelf = self;
         
+        // cells keep their bound thumbnails and only move, no reload
         [self.collectionView setCollectionViewLayout:layout animated:NO completion:^(BOOL finished){
-            [weakSelf.collectionView reloadItemsAtIndexPaths:[weakSelf.collectionView indexPathsForVisibleItems]];
+            [weakSelf updateThumbnailsForVisibleItems];
         }];
     }
 }
 
 
 
+- (NSInteger)currentNumberOfColumns
+{
+    if (self.numberOfColumns > 0)
+        return self.numberOfColumns;
+    
+    return [KITAssetsGridViewLayout numberOfColumnsForTraitCollection:self.traitCollection];
+}
+
+// Layouts are cached per width, traits and density, so rotating, resizing and zooming back reuse them
+- (KITAssetsGridViewLayout *)gridLayoutWithNumberOfColumns:(NSInteger)numberOfColumns
+{
+    CGSize contentSize = self.view.bounds.size;
+    UITraitCollection *trait = self.traitCollection;
+    
+    if (!self.gridLayouts)
+    {
+        self.gridLayouts = [NSCache new];
+        self.gridLayouts.countLimit = 16;
+    }
+    
+    NSString *key = [self gridLayoutKeyForContentSize:contentSize traitCollection:trait numberOfColumns:numberOfColumns];
+    KITAssetsGridViewLayout *layout = [self.gridLayouts objectForKey:key];
+    
+    if (!layout)
+    {
+        layout = [[KITAssetsGridViewLayout alloc] initWithContentSize:contentSize numberOfColumns:numberOfColumns traitCollection:trait];
+        [self.gridLayouts setObject:layout forKey:key];
+    }
+    
+    [self updateLayoutSections:layout];
+    
+    return layout;
+}
+
+- (NSString *)gridLayoutKeyForContentSize:(CGSize)contentSize traitCollection:(UITraitCollection *)trait numberOfColumns:(NSInteger)numberOfColumns
+{
+    // the grid only depends on the width; sub-pixel differences share an entry
+    CGFloat scale = (trait.displayScale > 0) ? trait.displayScale : UIScreen.mainScreen.scale;
+    long pixelWidth = lround(contentSize.width * scale);
+    
+    return [NSString stringWithFormat:@"%ld-%.0f-%ld-%ld-%ld-%ld",
+            pixelWidth, scale,
+            (long)trait.userInterfaceIdiom, (long)trait.horizontalSizeClass, (long)trait.verticalSizeClass,
+            (long)numberOfColumns];
+}
+
+
+
+#pragma mark - Pinch to zoom
+
+- (void)pinchGridLayout:(UIPinchGestureRecognizer *)pinch
+{
+    switch (pinch.state)
+    {
+        case UIGestureRecognizerStateChanged:
+        {
+            if (!self.transitionLayout)
+                [self startGridLayoutTransitionWithScale:pinch.scale];
+            
+            if (self.transitionLayout)
+            {
+                // item size changes by the ratio of the column counts
+                CGFloat targetScale = (CGFloat)[self currentNumberOfColumns] / self.transitionNumberOfColumns;
+                CGFloat progress = (pinch.scale - 1) / (targetScale - 1);
+                
+                self.transitionLayout.transitionProgress = MIN(MAX(progress, 0), 1);
+            }
+            break;
+        }
+        case UIGestureRecognizerStateEnded:
+        case UIGestureRecognizerStateCancelled:
+        case UIGestureRecognizerStateFailed:
+        {
+            if (!self.transitionLayout)
+                break;
+            
+            if (pinch.state == UIGestureRecognizerStateEnded && self.transitionLayout.transitionProgress > 0.5)
+                [self.collectionView finishInteractiveTransition];
+            else
+                [self.collectionView cancelInteractiveTransition];
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+- (void)startGridLayoutTransitionWithScale:(CGFloat)scale
+{
+    if (!self.picker.allowsPinchToZoomGrid || ![self.collectionViewLayout isKindOfClass:KITAssetsGridViewLayout.class])
+        return;
+    
+    // wait until the direction is clear
+    if (fabs(scale - 1) < 0.05)
+        return;
+    
+    NSInteger numberOfColumns = [self currentNumberOfColumns];
+    NSInteger targetNumberOfColumns = (scale < 1) ? numberOfColumns + 1 : numberOfColumns - 1;
+    
+    if (targetNumberOfColumns < KITAssetsGridViewMinimumNumberOfColumns ||
+        targetNumberOfColumns > KITAssetsGridViewMaximumNumberOfColumns)
+        return;
+    
+    __weak KITAssetsGridViewController *weakSelf = self;
+    
+    self.transitionNumberOfColumns = targetNumberOfColumns;
+    self.transitionLayout =
+    [self.collectionView startInteractiveTransitionToCollectionViewLayout:[self gridLayoutWithNumberOfColumns:targetNumberOfColumns]
+                                                               completion:^(BOOL completed, BOOL finished) {
+                                                                   [weakSelf didFinishGridLayoutTransition:completed];
+                                                               }];
+}
+
+- (void)didFinishGridLayoutTransition:(BOOL)completed
+{
+    if (completed)
+    {
+        self.numberOfColumns = self.transitionNumberOfColumns;
+        [self updateThumbnailsForVisibleItems];
+    }
+    
+    self.transitionLayout = nil;
+    self.transitionNumberOfColumns = 0;
+    [self resetCachedAssetImages];
+    [self updateCachedAssetImages];
+}
+
+
+
 #pragma mark - Scroll to bottom
 
+- (void)scrollToBottomOnceIfNeeded
+{
+    if (self.didLayoutSubviews || self.assetCollection.count == 0)
+        return;
+    
+    [self scrollToBottomIfNeeded];
+    self.didLayoutSubviews = YES;
+}
+
 - (void)scrollToBottomIfNeeded
 {
     BOOL shouldScrollToBottom;
@@ -231,9 +679,25 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
     else
         shouldScrollToBottom = YES;
  
-    if (shouldScrollToBottom)
+    if (!shouldScrollToBottom)
+        return;
+    
+    if ([self.collectionViewLayout isKindOfClass:KITAssetsGridViewLayout.class])
     {
-        NSIndexPath *indexPath = [NSIndexPath indexPathForItem:self.assetCollection.count-1 inSection:0];
+        // the content height is arithmetic, so the end offset is known without laying out any cell
+        KITAssetsGridViewLayout *layout = (KITAssetsGridViewLayout *)self.collectionViewLayout;
+        [layout prepareLayout];
+        
+        UIEdgeInsets insets = [self scrollInsets];
+        CGFloat offsetY =
+        KITAssetsGridViewLayoutBottomOffset(layout.collectionViewContentSize.height, CGRectGetHeight(self.collectionView.bounds),
+                                            insets.top, insets.bottom);
+        
+        [self.collectionView setContentOffset:CGPointMake(self.collectionView.contentOffset.x, offsetY) animated:NO];
+    }
+    else
+    {
+        NSIndexPath *indexPath = [self indexPathForAssetIndex:self.assetCollection.count-1];
         [self.collectionView scrollToItemAtIndexPath:indexPath atScrollPosition:UICollectionViewScrollPositionTop animated:NO];
     }
 }
@@ -255,6 +719,16 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
                selector:@selector(assetsPickerDidDeselectAsset:)
                    name:KITAssetsPickerDidDeselectAssetNotification
                  object:nil];
+    
+    [center addObserver:self
+               selector:@selector(contentSizeCategoryChanged:)
+                   name:UIContentSizeCategoryDidChangeNotification
+                 object:nil];
+    
+    [center addObserver:self
+               selector:@selector(assetCollectionDidChange:)
+                   name:KITAssetCollectionDidChangeNotification
+                 object:nil];
 }
 
 - (void)removeNotificationObserver
@@ -263,6 +737,8 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
     
     [center removeObserver:self name:KITAssetsPickerDidSelectAssetNotification object:nil];
     [center removeObserver:self name:KITAssetsPickerDidDeselectAssetNotification object:nil];
+    [center removeObserver:self name:UIContentSizeCategoryDidChangeNotification object:nil];
+    [center removeObserver:self name:KITAssetCollectionDidChangeNotification object:nil];
 }
 
 
@@ -271,8 +747,10 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
 - (void)assetsPickerDidSelectAsset:(NSNotification *)notification
 {
     id<KITAssetDataSource> asset = (id<KITAssetDataSource> )notification.object;
-    NSIndexPath *indexPath = [NSIndexPath indexPathForItem:[self.assetCollection indexOfObject:asset] inSection:0];
-    [self.collectionView selectItemAtIndexPath:indexPath animated:NO scrollPosition:UICollectionViewScrollPositionNone];
+    NSIndexPath *indexPath = [self indexPathForAsset:asset];
+    
+    if (indexPath)
+        [self.collectionView selectItemAtIndexPath:indexPath animated:NO scrollPosition:UICollectionViewScrollPositionNone];
     
     [self updateSelectionOrderLabels];
 }
@@ -280,13 +758,155 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
 - (void)assetsPickerDidDeselectAsset:(NSNotification *)notification
 {
     id<KITAssetDataSource> asset = (id<KITAssetDataSource> )notification.object;
-    NSIndexPath *indexPath = [NSIndexPath indexPathForItem:[self.assetCollection indexOfObject:asset] inSection:0];
-    [self.collectionView deselectItemAtIndexPath:indexPath animated:NO];
+    NSIndexPath *indexPath = [self indexPathForAsset:asset];
+    
+    if (indexPath)
+        [self.collectionView deselectItemAtIndexPath:indexPath animated:NO];
     
     [self updateSelectionOrderLabels];
 }
 
 
+#pragma mark - Asset collection changes
+
+- (void)assetCollectionDidChange:(NSNotification *)notification
+{
+    if (notification.object != self.assetCollection)
+        return;
+    
+    KITAssetCollectionChangeSet *changeSet = notification.userInfo[KITAssetCollectionChangeSetKey];
+    
+    [self applyChangeSet:changeSet keepsBottomVisible:YES];
+}
+
+// keeps the picker's selection, and so the selection order, free of assets that no longer exist;
+// called once the grid is in its new state, as every deselection posts a notification the grid handles
+- (void)deselectRemovedAssets:(NSArray *)removedAssets
+{
+    for (id<KITAssetDataSource> asset in removedAssets)
+    {
+        if ([self.picker.selectedAssets containsObject:asset])
+            [self.picker deselectAsset:asset];
+    }
+}
+
+// The selected assets at the removed indexes, found by their index before the change: the index map still
+// describes the old contents until it is invalidated, and the asset window covers the rows around the screen.
+- (NSArray *)selectedAssetsAtRemovedIndexes:(NSIndexSet *)removedIndexes
+{
+    NSMutableArray *assets = [NSMutableArray new];
+    
+    if (removedIndexes.count == 0)
+        return assets;
+    
+    BOOL isMapBuilt = self.assetIndexMap.isBuilt;
+    
+    for (id<KITAssetDataSource> asset in self.picker.selectedAssets)
+    {
+        NSUInteger index = NSNotFound;
+        
+        if (isMapBuilt)
+        {
+            index = [self.assetIndexMap indexOfAsset:asset];
+        }
+        else
+        {
+            NSUInteger windowIndex = [self.assetWindow indexOfObject:asset];
+            
+            if (windowIndex != NSNotFound)
+                index = self.assetWindowRange.location + windowIndex;
+        }
+        
+        if (index != NSNotFound && [removedIndexes containsIndex:index])
+            [assets addObject:asset];
+    }
+    
+    return assets;
+}
+
+- (void)applyChangeSet:(KITAssetCollectionChangeSet *)changeSet keepsBottomVisible:(BOOL)keepsBottomVisible
+{
+    NSArray *removedAssets = (changeSet.removedObjects) ? changeSet.removedObjects : [self selectedAssetsAtRemovedIndexes:changeSet.removedIndexes];
+    
+    [self resetAssetWindow];
+    [self.assetIndexMap invalidate];
+    
+    // asking for the collection view would load the view; it reloads when it appears anyway
+    if (!self.isViewLoaded)
+    {
+        self.sectionIndex = nil;
+        [self deselectRemovedAssets:removedAssets];
+        return;
+    }
+    
+    UICollectionView *collectionView = self.collectionView;
+    NSInteger numberOfItems = (collectionView.numberOfSections > 0) ? [collectionView numberOfItemsInSection:0] : 0;
+    
+    // sections depend on every date, and an empty grid has the no-assets view to swap
+    BOOL needsReload = (!changeSet.hasIncrementalChanges || self.sectionIndex ||
+                        numberOfItems == 0 || self.assetCollection.count == 0 ||
+                        numberOfItems - changeSet.removedIndexes.count + changeSet.insertedIndexes.count != self.assetCollection.count);
+    
+    if (needsReload)
+    {
+        self.sectionIndex = nil;
+        [self reloadData];
+        [self deselectRemovedAssets:removedAssets];
+        [self buildSectionIndexIfNeeded];
+        return;
+    }
+    
+    BOOL isAtBottom = (keepsBottomVisible && collectionView.contentOffset.y >= [self maximumContentOffsetY] - 1);
+    
+    NSArray *changedIndexPaths = [self indexPathsFromIndexes:changeSet.changedIndexes];
+    
+    [collectionView performBatchUpdates:^{
+        [collectionView deleteItemsAtIndexPaths:[self indexPathsFromIndexes:changeSet.removedIndexes]];
+        [collectionView insertItemsAtIndexPaths:[self indexPathsFromIndexes:changeSet.insertedIndexes]];
+        
+        [changeSet enumerateMovesWithBlock:^(NSUInteger fromIndex, NSUInteger toIndex) {
+            [collectionView moveItemAtIndexPath:[NSIndexPath indexPathForItem:fromIndex inSection:0]
+                                    toIndexPath:[NSIndexPath indexPathForItem:toIndex inSection:0]];
+        }];
+    } completion:^(BOOL finished) {
+        // changed assets are rebound after the moves; other cells keep their thumbnails
+        if (changedIndexPaths.count > 0)
+            [collectionView reloadItemsAtIndexPaths:changedIndexPaths];
+        
+        [self updateSelectionOrderLabels];
+        [self.footer bind:self.assetCollection];
+        
+        // a grid following the newest assets keeps following them
+        if (isAtBottom)
+            [collectionView setContentOffset:CGPointMake(collectionView.contentOffset.x, [self maximumContentOffsetY]) animated:YES];
+    }];
+    
+    // the updates are applied to the grid's model by now, even while they animate
+    [self deselectRemovedAssets:removedAssets];
+}
+
+- (NSArray *)indexPathsFromIndexes:(NSIndexSet *)indexes
+{
+    NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:indexes.count];
+    
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [indexPaths addObject:[NSIndexPath indexPathForItem:index inSection:0]];
+    }];
+    
+    return indexPaths;
+}
+
+
+#pragma mark - Content size category changed
+
+- (void)contentSizeCategoryChanged:(NSNotification *)notification
+{
+    // purge first, the cache may not have seen the notification yet
+    [[KITAssetOverlayImageCache sharedCache] removeAllImages];
+    [self.collectionView reloadItemsAtIndexPaths:[self.collectionView indexPathsForVisibleItems]];
+}
+
+
 #pragma mark - Update Selection Order Labels
 
 - (void)updateSelectionOrderLabels
@@ -308,6 +928,11 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
     [[UILongPressGestureRecognizer alloc] initWithTarget:self action:@selector(pushPageViewController:)];
     
     [self.collectionView addGestureRecognizer:longPress];
+    
+    UIPinchGestureRecognizer *pinch =
+    [[UIPinchGestureRecognizer alloc] initWithTarget:self action:@selector(pinchGridLayout:)];
+    
+    [self.collectionView addGestureRecognizer:pinch];
 }
 
 
@@ -320,9 +945,13 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
         CGPoint point           = [longPress locationInView:self.collectionView];
         NSIndexPath *indexPath  = [self.collectionView indexPathForItemAtPoint:point];
         
-        KITAssetsPageViewController *vc = [[KITAssetsPageViewController alloc] initWithCollection:self.picker.collectionDataSources[indexPath.row]];
+        // placeholders have nothing to show yet
+        if (!indexPath || ![self isAssetLoadedAtIndex:[self assetIndexForIndexPath:indexPath]])
+            return;
+        
+        KITAssetsPageViewController *vc = [[KITAssetsPageViewController alloc] initWithCollection:self.assetCollection];
         vc.allowsSelection = YES;
-        vc.pageIndex = indexPath.item;
+        vc.pageIndex = [self assetIndexForIndexPath:indexPath];
 
         [self.navigationController pushViewController:vc animated:YES];
     }
@@ -333,7 +962,11 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
 
 - (void)reloadData
 {
-    if (self.assetCollection.count > 0)
+    [self resetAssetWindow];
+    [self.assetIndexMap invalidate];
+    
+    // a paged collection still loading its first page is not empty yet
+    if (self.assetCollection.count > 0 || self.isLoadingMoreAssets)
     {
         [self hideNoAssets];
         [self.collectionView reloadData];
@@ -352,6 +985,76 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
     self.previousPreheatRect = CGRectZero;
 }
 
+- (void)resetAssetWindow
+{
+    self.assetWindow = nil;
+    self.assetWindowRange = NSMakeRange(0, 0);
+}
+
+// The preheat window is twice the height of the visible rect
+- (CGRect)preheatRect
+{
+    CGRect preheatRect = self.collectionView.bounds;
+    return CGRectInset(preheatRect, 0.0f, -0.5f * CGRectGetHeight(preheatRect));
+}
+
+// Fetches the assets of a rect with one range request
+- (void)updateAssetWindowForRect:(CGRect)rect
+{
+    NSRange range = [self assetRangeForRect:rect];
+    
+    if (range.location == NSNotFound || NSEqualRanges(range, self.assetWindowRange))
+        return;
+    
+    id<KITAsyncAssetCollectionDataSource> collection = [self asyncAssetCollection];
+    
+    // placeholders are not fetched
+    if (collection && ![collection areObjectsLoadedInRange:range])
+        return;
+    
+    NSArray *assets = KITAssetCollectionObjectsInRange(self.assetCollection, range);
+    
+    if (assets.count != range.length)
+        return;
+    
+    self.assetWindow = assets;
+    self.assetWindowRange = range;
+}
+
+- (NSRange)assetRangeForRect:(CGRect)rect
+{
+    NSUInteger firstIndex = NSNotFound;
+    NSUInteger lastIndex = 0;
+    
+    for (UICollectionViewLayoutAttributes *attributes in [self.collectionViewLayout layoutAttributesForElementsInRect:rect])
+    {
+        if (attributes.representedElementCategory != UICollectionElementCategoryCell)
+            continue;
+        
+        NSUInteger index = [self assetIndexForIndexPath:attributes.indexPath];
+        firstIndex = MIN(firstIndex, index);
+        lastIndex = MAX(lastIndex, index);
+    }
+    
+    if (firstIndex == NSNotFound || lastIndex >= self.assetCollection.count)
+        return NSMakeRange(NSNotFound, 0);
+    
+    return NSMakeRange(firstIndex, lastIndex - firstIndex + 1);
+}
+
+- (void)startCachingThumbnailsForIndexPaths:(NSArray *)indexPaths
+{
+    KITAssetThumbnailGenerator *generator = [KITAssetThumbnailGenerator sharedGenerator];
+    
+    for (NSIndexPath *indexPath in indexPaths)
+    {
+        id<KITAssetDataSource> asset = [self assetAtIndexPath:indexPath];
+        
+        if (asset)
+            [generator requestThumbnailForAsset:asset targetSize:[self thumbnailTargetSizeForItemAtIndexPath:indexPath] completionHandler:^(UIImage *image){}];
+    }
+}
+
 - (void)updateCachedAssetImages
 {
     BOOL isViewVisible = [self isViewLoaded] && [[self view] window] != nil;
@@ -359,9 +1062,7 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
     if (!isViewVisible)
         return;
     
-    // The preheat window is twice the height of the visible rect
-    CGRect preheatRect = self.collectionView.bounds;
-    preheatRect = CGRectInset(preheatRect, 0.0f, -0.5f * CGRectGetHeight(preheatRect));
+    CGRect preheatRect = [self preheatRect];
     
     // If scrolled by a "reasonable" amount...
     CGFloat delta = ABS(CGRectGetMidY(preheatRect) - CGRectGetMidY(self.previousPreheatRect));
@@ -382,6 +1083,10 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
                                 [addedIndexPaths addObjectsFromArray:indexPaths];
                             }];
         
+        [self loadAssetsInRectIfNeeded:preheatRect];
+        [self updateAssetWindowForRect:preheatRect];
+        [self startCachingThumbnailsForIndexPaths:addedIndexPaths];
+        
         self.previousPreheatRect = preheatRect;
     }
 }
@@ -420,9 +1125,154 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
 
 - (void)scrollViewDidScroll:(UIScrollView *)scrollView
 {
+    if (!self.isPrewarmingCells && !self.isScrubbing)
+        [self updateCachedAssetImages];
+    
+    [self layoutScrubber];
+}
+
+
+#pragma mark - Scrubber
+
+- (UIEdgeInsets)scrollInsets
+{
+    if ([[[UIDevice currentDevice] systemVersion] floatValue] >= 11)
+        return self.collectionView.adjustedContentInset;
+    else
+        return self.collectionView.contentInset;
+}
+
+- (CGFloat)maximumContentOffsetY
+{
+    UIEdgeInsets insets = [self scrollInsets];
+    CGFloat maxOffsetY = self.collectionView.contentSize.height + insets.bottom - CGRectGetHeight(self.collectionView.bounds);
+    
+    return MAX(-insets.top, maxOffsetY);
+}
+
+// keeps the scrubber pinned to the trailing edge of the visible rect
+- (void)layoutScrubber
+{
+    UICollectionView *collectionView = self.collectionView;
+    KITAssetsGridScrubber *scrubber = self.scrubber;
+    CGRect bounds = collectionView.bounds;
+    
+    BOOL isLong = (collectionView.contentSize.height > CGRectGetHeight(bounds) * KITAssetsGridScrubberMinimumNumberOfScreens);
+    scrubber.hidden = !(self.picker.showsScrubber && isLong);
+    
+    if (scrubber.hidden)
+        return;
+    
+    UIEdgeInsets insets = [self scrollInsets];
+    BOOL isRightToLeft = ([UIApplication sharedApplication].userInterfaceLayoutDirection == UIUserInterfaceLayoutDirectionRightToLeft);
+    CGFloat x = (isRightToLeft) ? CGRectGetMinX(bounds) : CGRectGetMaxX(bounds) - KITAssetsGridScrubberWidth;
+    
+    scrubber.frame = CGRectMake(x,
+                                CGRectGetMinY(bounds) + insets.top,
+                                KITAssetsGridScrubberWidth,
+                                CGRectGetHeight(bounds) - insets.top - insets.bottom);
+    
+    [collectionView bringSubviewToFront:scrubber];
+    
+    if (!self.isScrubbing)
+    {
+        CGFloat travel = [self maximumContentOffsetY] + insets.top;
+        scrubber.value = (travel > 0) ? (collectionView.contentOffset.y + insets.top) / travel : 0;
+    }
+}
+
+- (void)scrubberDidBegin:(KITAssetsGridScrubber *)scrubber
+{
+    self.scrubbing = YES;
+    scrubber.title = [self scrubberTitleForAssetIndex:[self assetIndexForScrubberValue:scrubber.value]];
+}
+
+- (void)scrubberValueChanged:(KITAssetsGridScrubber *)scrubber
+{
+    NSUInteger index = [self assetIndexForScrubberValue:scrubber.value];
+    NSIndexPath *indexPath = [self indexPathForAssetIndex:index];
+    
+    if (!indexPath)
+        return;
+    
+    // O(1) in the grid layout; the item lands at the top of the screen
+    UICollectionViewLayoutAttributes *attributes = [self.collectionViewLayout layoutAttributesForItemAtIndexPath:indexPath];
+    UIEdgeInsets insets = [self scrollInsets];
+    
+    CGFloat offsetY = MIN(MAX(CGRectGetMinY(attributes.frame) - insets.top, -insets.top), [self maximumContentOffsetY]);
+    
+    scrubber.title = [self scrubberTitleForAssetIndex:index];
+    [self.collectionView setContentOffset:CGPointMake(self.collectionView.contentOffset.x, offsetY) animated:NO];
+}
+
+- (void)scrubberDidEnd:(KITAssetsGridScrubber *)scrubber
+{
+    self.scrubbing = NO;
+    
+    [self requestThumbnailsForVisibleItemsProgressively];
+    [self resetCachedAssetImages];
     [self updateCachedAssetImages];
 }
 
+- (NSUInteger)assetIndexForScrubberValue:(CGFloat)value
+{
+    NSUInteger count = self.assetCollection.count;
+    return (count > 0) ? (NSUInteger)lround(value * (count - 1)) : NSNotFound;
+}
+
+- (NSString *)scrubberTitleForAssetIndex:(NSUInteger)index
+{
+    if (!self.sectionIndex || index == NSNotFound)
+        return nil;
+    
+    NSDate *date = [self.sectionIndex dateForSection:[self.sectionIndex sectionForIndex:index]];
+    
+    return [KITAssetsGridViewSectionHeader titleForDate:date];
+}
+
+
+#pragma mark - Prewarm cells
+
+- (void)prewarmCellsWhenIdle
+{
+    if (self.didPrewarmCells)
+        return;
+    
+    self.didPrewarmCells = YES;
+    
+    __weak typeof(self) weakSelf = self;
+    
+    [KITAssetsPickerPrewarmer performWhenIdleWithSignpostCode:KITAssetsPickerPrewarmCellsSignpostCode block:^{
+        [weakSelf prewarmCells];
+    }];
+}
+
+// Lays out one extra row above and below the visible rect, then shrinks back.
+// The extra cells are enqueued for reuse, so the first scroll dequeues instead of building cells.
+- (void)prewarmCells
+{
+    UICollectionView *collectionView = self.collectionView;
+    
+    if (!collectionView.window || self.assetCollection.count == 0)
+        return;
+    
+    UICollectionViewLayoutAttributes *attributes =
+    [self.collectionViewLayout layoutAttributesForItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:0]];
+    
+    CGFloat rowHeight = CGRectGetHeight(attributes.frame);
+    CGRect bounds = collectionView.bounds;
+    
+    self.prewarmingCells = YES;
+    
+    collectionView.bounds = CGRectInset(bounds, 0, -rowHeight);
+    [collectionView layoutIfNeeded];
+    
+    collectionView.bounds = bounds;
+    [collectionView layoutIfNeeded];
+    
+    self.prewarmingCells = NO;
+}
+
 
 #pragma mark - No assets
 
@@ -450,26 +1300,31 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
 
 - (NSInteger)numberOfSectionsInCollectionView:(UICollectionView *)collectionView
 {
-    return 1;
+    return (self.sectionIndex) ? self.sectionIndex.numberOfSections : 1;
 }
 
 - (NSInteger)collectionView:(UICollectionView *)collectionView numberOfItemsInSection:(NSInteger)section
 {
-    return self.assetCollection.count;
+    return (self.sectionIndex) ? [self.sectionIndex numberOfItemsInSection:section] : self.assetCollection.count;
 }
 
 - (UICollectionViewCell *)collectionView:(UICollectionView *)collectionView cellForItemAtIndexPath:(NSIndexPath *)indexPath
 {
+    NSString *identifier = (self.picker.usesFlattenedGridCells) ? KITAssetsGridFlatViewCellIdentifier : KITAssetsGridViewCellIdentifier;
+    
     KITAssetsGridViewCell *cell =
-    [collectionView dequeueReusableCellWithReuseIdentifier:KITAssetsGridViewCellIdentifier
+    [collectionView dequeueReusableCellWithReuseIdentifier:identifier
                                               forIndexPath:indexPath];
     
     id<KITAssetDataSource> asset = [self assetAtIndexPath:indexPath];
     
-    if ([self.picker.delegate respondsToSelector:@selector(assetsPickerController:shouldEnableAsset:)])
-        cell.enabled = [self.picker.delegate assetsPickerController:self.picker shouldEnableAsset:asset];
+    // placeholders stay disabled without asking the delegate; the cell is reloaded once its page arrives
+    if (asset)
+        cell.enabled = [self.picker shouldEnableAsset:asset
+                                              atIndex:[self assetIndexForIndexPath:indexPath]
+                                    inAssetCollection:self.assetCollection];
     else
-        cell.enabled = YES;
+        cell.enabled = NO;
     
     cell.showsSelectionIndex = self.picker.showsSelectionIndex;
     
@@ -485,14 +1340,88 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
     
     [cell bind:asset];
     
-    UICollectionViewLayoutAttributes *attributes =
-    [collectionView.collectionViewLayout layoutAttributesForItemAtIndexPath:indexPath];
+    // rows passed over while scrubbing get no thumbnail work; the landing screen is loaded when it ends
+    if (self.isScrubbing || !asset)
+    {
+        cell.tag = cell.tag + 1;
+        [self.thumbnailTargetSizes removeObjectForKey:cell];
+        
+        // never leave the reused cell's thumbnail behind, only show what is already cached
+        UIImage *image = nil;
+        
+        if (asset)
+            image = [[KITAssetThumbnailGenerator sharedGenerator] cachedThumbnailForAsset:asset
+                                                                              maximumSize:[self thumbnailTargetSizeForItemAtIndexPath:indexPath]];
+        
+        [cell bindImage:image];
+    }
+    else
+    {
+        CGSize targetSize = [self thumbnailTargetSizeForItemAtIndexPath:indexPath];
+        [self requestThumbnailForCell:cell targetSize:targetSize asset:asset];
+    }
+
+    return cell;
+}
+
+- (CGSize)thumbnailTargetSizeForItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    UICollectionViewLayout *layout = self.collectionView.collectionViewLayout;
+    CGSize itemSize;
     
-    CGSize targetSize = [self.picker imageSizeForContainerSize:attributes.size];
+    // mid-transition sizes are interpolated; use the larger end so the thumbnail is sharp either way
+    if ([layout isKindOfClass:UICollectionViewTransitionLayout.class])
+    {
+        UICollectionViewTransitionLayout *transitionLayout = (UICollectionViewTransitionLayout *)layout;
+        CGSize fromSize = [transitionLayout.currentLayout layoutAttributesForItemAtIndexPath:indexPath].size;
+        CGSize toSize = [transitionLayout.nextLayout layoutAttributesForItemAtIndexPath:indexPath].size;
+        itemSize = CGSizeMake(MAX(fromSize.width, toSize.width), MAX(fromSize.height, toSize.height));
+    }
+    else
+    {
+        itemSize = [layout layoutAttributesForItemAtIndexPath:indexPath].size;
+    }
     
-    [self requestThumbnailForCell:cell targetSize:targetSize asset:asset];
+    return [KITAssetThumbnailGenerator sizeClassForTargetSize:[self.picker imageSizeForContainerSize:itemSize]];
+}
 
-    return cell;
+// Requests thumbnails of the new size class for visible cells whose size class changed,
+// leaving the bound thumbnails in place until the new ones arrive
+- (void)updateThumbnailsForVisibleItems
+{
+    for (NSIndexPath *indexPath in [self.collectionView indexPathsForVisibleItems])
+    {
+        KITAssetsGridViewCell *cell = (KITAssetsGridViewCell *)[self.collectionView cellForItemAtIndexPath:indexPath];
+        CGSize targetSize = [self thumbnailTargetSizeForItemAtIndexPath:indexPath];
+        NSValue *boundTargetSize = [self.thumbnailTargetSizes objectForKey:cell];
+        
+        if (cell.asset && !(boundTargetSize && CGSizeEqualToSize(boundTargetSize.CGSizeValue, targetSize)))
+            [self requestThumbnailForCell:cell targetSize:targetSize asset:cell.asset];
+    }
+}
+
+// Fills the screen with the smaller thumbnails already cached, then replaces them with thumbnails of the grid's size class
+- (void)requestThumbnailsForVisibleItemsProgressively
+{
+    KITAssetThumbnailGenerator *generator = [KITAssetThumbnailGenerator sharedGenerator];
+    
+    for (NSIndexPath *indexPath in [self.collectionView indexPathsForVisibleItems])
+    {
+        KITAssetsGridViewCell *cell = (KITAssetsGridViewCell *)[self.collectionView cellForItemAtIndexPath:indexPath];
+        
+        if (!cell || !cell.asset)
+            continue;
+        
+        CGSize targetSize = [self thumbnailTargetSizeForItemAtIndexPath:indexPath];
+        
+        // only a cached rendition is cheaper; generating a preview would just hold up the real thumbnail
+        UIImage *preview = [generator cachedThumbnailForAsset:cell.asset maximumSize:targetSize];
+        
+        if (preview)
+            [cell bindImage:preview];
+        
+        [self requestThumbnailForCell:cell targetSize:targetSize asset:cell.asset];
+    }
 }
 
 - (void)requestThumbnailForCell:(KITAssetsGridViewCell *)cell targetSize:(CGSize)targetSize asset:(id<KITAssetDataSource> )asset
@@ -500,15 +1429,56 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
     NSInteger tag = cell.tag + 1;
     cell.tag = tag;
     
-    [asset thumbnailImageWithCompletionHandler:^(UIImage *image){
-        if (cell.tag == tag){
-            [(KITAssetThumbnailView *)cell.backgroundView bind:image asset:asset];
+    if (!self.thumbnailTargetSizes)
+        self.thumbnailTargetSizes = [NSMapTable weakToStrongObjectsMapTable];
+    
+    [self.thumbnailTargetSizes setObject:[NSValue valueWithCGSize:targetSize] forKey:cell];
+    
+    __weak KITAssetsGridViewController *weakSelf = self;
+    
+    [[KITAssetThumbnailGenerator sharedGenerator] requestThumbnailForAsset:asset targetSize:targetSize completionHandler:^(UIImage *image)
+    {
+        if (cell.tag == tag)
+        {
+            [cell bindImage:image];
+            [weakSelf didBindThumbnail];
         }
     }];
 }
 
+- (void)didBindThumbnail
+{
+    if (self.didBindFirstThumbnail)
+        return;
+    
+    self.didBindFirstThumbnail = YES;
+    [self endOpenSignpost];
+}
+
+// every start gets exactly one end, or the interval runs on in the trace
+- (void)endOpenSignpost
+{
+    if (!self.isSignpostingOpen)
+        return;
+    
+    self.signpostingOpen = NO;
+    [KITAssetsPickerPrewarmer signpostEnd:KITAssetsPickerOpenGridSignpostCode];
+}
+
 - (UICollectionReusableView *)collectionView:(UICollectionView *)collectionView viewForSupplementaryElementOfKind:(NSString *)kind atIndexPath:(NSIndexPath *)indexPath
 {
+    if ([kind isEqualToString:UICollectionElementKindSectionHeader])
+    {
+        KITAssetsGridViewSectionHeader *header =
+        [collectionView dequeueReusableSupplementaryViewOfKind:UICollectionElementKindSectionHeader
+                                           withReuseIdentifier:KITAssetsGridViewSectionHeaderIdentifier
+                                                  forIndexPath:indexPath];
+        
+        [header bind:[self.sectionIndex dateForSection:indexPath.section]];
+        
+        return header;
+    }
+    
     KITAssetsGridViewFooter *footer =
     [collectionView dequeueReusableSupplementaryViewOfKind:UICollectionElementKindSectionFooter
                                        withReuseIdentifier:KITAssetsGridViewFooterIdentifier
@@ -530,7 +1500,7 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
     
     KITAssetsGridViewCell *cell = (KITAssetsGridViewCell *)[collectionView cellForItemAtIndexPath:indexPath];
     
-    if (!cell.isEnabled)
+    if (!asset || !cell.isEnabled)
         return NO;
     else if ([self.picker.delegate respondsToSelector:@selector(assetsPickerController:shouldSelectAsset:)])
         return [self.picker.delegate assetsPickerController:self.picker shouldSelectAsset:asset];
@@ -604,7 +1574,9 @@ NSString * const KITAssetsGridViewFooterIdentifier = @"KITAssetsGridViewFooterId
 {
     id<KITAssetDataSource> asset = [self assetAtIndexPath:indexPath];
     
-    if ([self.picker.delegate respondsToSelector:@selector(assetsPickerController:shouldHighlightAsset:)])
+    if (!asset)
+        return NO;
+    else if ([self.picker.delegate respondsToSelector:@selector(assetsPickerController:shouldHighlightAsset:)])
         return [self.picker.delegate assetsPickerController:self.picker shouldHighlightAsset:asset];
     else
         return YES;
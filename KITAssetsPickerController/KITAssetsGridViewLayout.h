@@ -26,8 +26,55 @@
 
 #import <UIKit/UIKit.h>
 
-@interface KITAssetsGridViewLayout : UICollectionViewFlowLayout
+
+
+/**
+ *  A uniform grid layout.
+ *
+ *  Every item has the same size, so the frame of an item and the items in a rect are derived from
+ *  index arithmetic. Only per-section offsets are stored, which keeps `prepareLayout` independent of
+ *  the number of items. The properties mirror their `UICollectionViewFlowLayout` counterparts.
+ *
+ *  @warning It subclasses `UICollectionViewLayout`, no longer `UICollectionViewFlowLayout`. Code that casts the
+ *  grid's layout to a flow layout, sets `scrollDirection` or `estimatedItemSize`, or implements
+ *  `UICollectionViewDelegateFlowLayout` for the grid has to move to the properties below.
+ */
+@interface KITAssetsGridViewLayout : UICollectionViewLayout
 
 - (instancetype)initWithContentSize:(CGSize)contentSize traitCollection:(UITraitCollection *)traits;
 
+/**
+ *  Creates a layout with a given number of columns, instead of the default for the traits.
+ */
+- (instancetype)initWithContentSize:(CGSize)contentSize numberOfColumns:(NSInteger)numberOfColumns traitCollection:(UITraitCollection *)traits;
+
+/**
+ *  The default number of columns for a trait collection; 4 or 6 depending on the idiom and size classes.
+ */
++ (NSInteger)numberOfColumnsForTraitCollection:(UITraitCollection *)traits;
+
+@property (nonatomic, assign) CGFloat minimumLineSpacing;
+@property (nonatomic, assign) CGFloat minimumInteritemSpacing;
+@property (nonatomic, assign) CGSize itemSize;
+@property (nonatomic, assign) CGSize headerReferenceSize;
+@property (nonatomic, assign) CGSize footerReferenceSize;
+@property (nonatomic, assign) UIEdgeInsets sectionInset;
+
+/**
+ *  Determines whether the footer is laid out after the last section only, instead of after every section.
+ *
+ *  The default value is `NO`.
+ */
+@property (nonatomic, assign) BOOL showsFooterInLastSectionOnly;
+
+/**
+ *  The number of columns that fit in the collection view's width.
+ */
+@property (nonatomic, assign, readonly) NSInteger numberOfColumns;
+
+/**
+ *  The section whose header or first row is at or above a vertical content offset.
+ */
+- (NSInteger)sectionAtContentOffset:(CGFloat)offset;
+
 @end
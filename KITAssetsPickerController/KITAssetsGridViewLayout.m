@@ -25,15 +25,56 @@
  */
 
 #import "KITAssetsGridViewLayout.h"
+#import "KITAssetsGridViewLayoutGeometry.h"
+
+
+
+@interface KITAssetsGridViewLayout ()
+
+@property (nonatomic, assign, readwrite) NSInteger numberOfColumns;
+@property (nonatomic, assign) CGFloat interitemSpacing;
+@property (nonatomic, assign) CGFloat contentWidth;
+@property (nonatomic, assign) CGFloat contentHeight;
+
+@property (nonatomic, assign) KITAssetsGridViewLayoutSection *sections;
+@property (nonatomic, assign) NSInteger numberOfSections;
+
+@end
+
+
+
+
 
 @implementation KITAssetsGridViewLayout
 
-- (instancetype)initWithContentSize:(CGSize)contentSize traitCollection:(UITraitCollection *)traits
+- (instancetype)init
 {
     if (self = [super init])
     {
-        CGFloat scale = traits.displayScale;
-        NSInteger numberOfColumns = [self numberOfColumnsForTraitCollection:traits];
+        _minimumLineSpacing = 10;
+        _minimumInteritemSpacing = 10;
+        _itemSize = CGSizeMake(50, 50);
+        _headerReferenceSize = CGSizeZero;
+        _footerReferenceSize = CGSizeZero;
+        _sectionInset = UIEdgeInsetsZero;
+    }
+    
+    return self;
+}
+
+- (instancetype)initWithContentSize:(CGSize)contentSize traitCollection:(UITraitCollection *)traits
+{
+    return [self initWithContentSize:contentSize
+                     numberOfColumns:[self.class numberOfColumnsForTraitCollection:traits]
+                     traitCollection:traits];
+}
+
+- (instancetype)initWithContentSize:(CGSize)contentSize numberOfColumns:(NSInteger)numberOfColumns traitCollection:(UITraitCollection *)traits
+{
+    if (self = [self init])
+    {
+        // traits are nil or have no scale before iOS 8
+        CGFloat scale = (traits.displayScale > 0) ? traits.displayScale : UIScreen.mainScreen.scale;
         CGFloat onePixel = 1 / scale;
         
         // spacing is as small as possible
@@ -79,7 +120,12 @@
     return self;
 }
 
-- (NSInteger)numberOfColumnsForTraitCollection:(UITraitCollection *)traits
+- (void)dealloc
+{
+    free(_sections);
+}
+
++ (NSInteger)numberOfColumnsForTraitCollection:(UITraitCollection *)traits
 {
     switch (traits.userInterfaceIdiom) {
         case UIUserInterfaceIdiomPad:
@@ -106,4 +152,209 @@
     }
 }
 
+
+#pragma mark - Prepare layout
+
+- (void)prepareLayout
+{
+    [super prepareLayout];
+    
+    UICollectionView *collectionView = self.collectionView;
+    UIEdgeInsets insets = self.sectionInset;
+    
+    self.contentWidth = CGRectGetWidth(collectionView.bounds);
+    
+    // columns and spacing as flow layout would justify them
+    CGFloat availableWidth = self.contentWidth - insets.left - insets.right;
+    CGFloat itemWidth = self.itemSize.width;
+    
+    NSInteger numberOfColumns = (itemWidth > 0) ? (NSInteger)floor((availableWidth + self.minimumInteritemSpacing) / (itemWidth + self.minimumInteritemSpacing)) : 1;
+    numberOfColumns = MAX(1, numberOfColumns);
+    
+    self.numberOfColumns = numberOfColumns;
+    self.interitemSpacing = (numberOfColumns > 1) ? MAX(self.minimumInteritemSpacing, (availableWidth - itemWidth * numberOfColumns) / (numberOfColumns - 1)) : 0;
+    
+    NSInteger numberOfSections = [collectionView numberOfSections];
+    
+    if (numberOfSections != self.numberOfSections)
+    {
+        free(self.sections);
+        self.sections = (numberOfSections > 0) ? calloc(numberOfSections, sizeof(KITAssetsGridViewLayoutSection)) : NULL;
+        self.numberOfSections = numberOfSections;
+    }
+    
+    for (NSInteger section = 0; section < numberOfSections; section++)
+        self.sections[section].numberOfItems = [collectionView numberOfItemsInSection:section];
+    
+    self.contentHeight = KITAssetsGridViewLayoutPlaceSections(self.sections, numberOfSections, [self metrics]);
+}
+
+- (KITAssetsGridViewLayoutMetrics)metrics
+{
+    KITAssetsGridViewLayoutMetrics metrics;
+    
+    metrics.numberOfColumns                 = self.numberOfColumns;
+    metrics.itemHeight                      = self.itemSize.height;
+    metrics.lineSpacing                     = self.minimumLineSpacing;
+    metrics.headerHeight                    = self.headerReferenceSize.height;
+    metrics.footerHeight                    = self.footerReferenceSize.height;
+    metrics.sectionInsetTop                 = self.sectionInset.top;
+    metrics.sectionInsetBottom              = self.sectionInset.bottom;
+    metrics.showsFooterInLastSectionOnly    = self.showsFooterInLastSectionOnly;
+    
+    return metrics;
+}
+
+- (BOOL)showsFooterInSection:(NSInteger)section
+{
+    return KITAssetsGridViewLayoutShowsFooter([self metrics], section, self.numberOfSections);
+}
+
+- (CGSize)collectionViewContentSize
+{
+    return CGSizeMake(self.contentWidth, self.contentHeight);
+}
+
+- (BOOL)shouldInvalidateLayoutForBoundsChange:(CGRect)newBounds
+{
+    return (CGRectGetWidth(newBounds) != self.contentWidth);
+}
+
+
+#pragma mark - Frames
+
+- (CGFloat)rowHeight
+{
+    return self.itemSize.height + self.minimumLineSpacing;
+}
+
+- (CGFloat)screenScale
+{
+    CGFloat scale = 0;
+    
+    if ([self.collectionView respondsToSelector:@selector(traitCollection)])
+        scale = self.collectionView.traitCollection.displayScale;
+    
+    return (scale > 0) ? scale : UIScreen.mainScreen.scale;
+}
+
+- (CGRect)frameForItem:(NSInteger)item inSection:(KITAssetsGridViewLayoutSection *)info
+{
+    NSInteger row    = item / self.numberOfColumns;
+    NSInteger column = item % self.numberOfColumns;
+    
+    CGFloat scale = [self screenScale];
+    CGFloat x = self.sectionInset.left + column * (self.itemSize.width + self.interitemSpacing);
+    CGFloat y = info->itemsTop + row * [self rowHeight];
+    
+    // snap the origin to a pixel, as flow layout does
+    return CGRectMake(round(x * scale) / scale, round(y * scale) / scale, self.itemSize.width, self.itemSize.height);
+}
+
+- (NSInteger)sectionAtContentOffset:(CGFloat)offset
+{
+    return KITAssetsGridViewLayoutSectionAtOffset(self.sections, self.numberOfSections, offset);
+}
+
+
+#pragma mark - Layout attributes
+
+- (NSArray<UICollectionViewLayoutAttributes *> *)layoutAttributesForElementsInRect:(CGRect)rect
+{
+    NSMutableArray *attributes = [NSMutableArray new];
+    
+    if (self.numberOfSections == 0 || CGRectIsEmpty(rect))
+        return attributes;
+    
+    KITAssetsGridViewLayoutMetrics metrics = [self metrics];
+    
+    for (NSInteger section = [self sectionAtContentOffset:CGRectGetMinY(rect)]; section < self.numberOfSections; section++)
+    {
+        KITAssetsGridViewLayoutSection *info = &self.sections[section];
+        
+        if (info->top >= CGRectGetMaxY(rect))
+            break;
+        
+        NSIndexPath *sectionIndexPath = [NSIndexPath indexPathForItem:0 inSection:section];
+        
+        UICollectionViewLayoutAttributes *header =
+        [self layoutAttributesForSupplementaryViewOfKind:UICollectionElementKindSectionHeader atIndexPath:sectionIndexPath];
+        
+        if (header && CGRectIntersectsRect(header.frame, rect))
+            [attributes addObject:header];
+        
+        NSInteger firstItem, lastItem;
+        
+        if (KITAssetsGridViewLayoutItemsInBand(info, metrics, CGRectGetMinY(rect), CGRectGetMaxY(rect), &firstItem, &lastItem))
+        {
+            for (NSInteger item = firstItem; item <= lastItem; item++)
+            {
+                CGRect frame = [self frameForItem:item inSection:info];
+                
+                if (CGRectIntersectsRect(frame, rect))
+                    [attributes addObject:[self layoutAttributesForItemAtIndex:item inSection:section frame:frame]];
+            }
+        }
+        
+        UICollectionViewLayoutAttributes *footer =
+        [self layoutAttributesForSupplementaryViewOfKind:UICollectionElementKindSectionFooter atIndexPath:sectionIndexPath];
+        
+        if (footer && CGRectIntersectsRect(footer.frame, rect))
+            [attributes addObject:footer];
+    }
+    
+    return attributes;
+}
+
+- (UICollectionViewLayoutAttributes *)layoutAttributesForItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    if (indexPath.section >= self.numberOfSections)
+        return nil;
+    
+    KITAssetsGridViewLayoutSection *info = &self.sections[indexPath.section];
+    
+    if (indexPath.item >= info->numberOfItems)
+        return nil;
+    
+    CGRect frame = [self frameForItem:indexPath.item inSection:info];
+    
+    return [self layoutAttributesForItemAtIndex:indexPath.item inSection:indexPath.section frame:frame];
+}
+
+- (UICollectionViewLayoutAttributes *)layoutAttributesForItemAtIndex:(NSInteger)item inSection:(NSInteger)section frame:(CGRect)frame
+{
+    NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:section];
+    
+    UICollectionViewLayoutAttributes *attributes =
+    [[[self class] layoutAttributesClass] layoutAttributesForCellWithIndexPath:indexPath];
+    
+    attributes.frame = frame;
+    
+    return attributes;
+}
+
+- (UICollectionViewLayoutAttributes *)layoutAttributesForSupplementaryViewOfKind:(NSString *)elementKind atIndexPath:(NSIndexPath *)indexPath
+{
+    if (indexPath.section >= self.numberOfSections)
+        return nil;
+    
+    KITAssetsGridViewLayoutSection *info = &self.sections[indexPath.section];
+    CGRect frame;
+    
+    if ([elementKind isEqualToString:UICollectionElementKindSectionHeader] && self.headerReferenceSize.height > 0)
+        frame = CGRectMake(0, info->top, self.contentWidth, self.headerReferenceSize.height);
+    else if ([elementKind isEqualToString:UICollectionElementKindSectionFooter] && [self showsFooterInSection:indexPath.section])
+        frame = CGRectMake(0, info->bottom - self.footerReferenceSize.height, self.contentWidth, self.footerReferenceSize.height);
+    else
+        return nil;
+    
+    UICollectionViewLayoutAttributes *attributes =
+    [[[self class] layoutAttributesClass] layoutAttributesForSupplementaryViewOfKind:elementKind
+                                                                       withIndexPath:[NSIndexPath indexPathForItem:0 inSection:indexPath.section]];
+    
+    attributes.frame = frame;
+    
+    return attributes;
+}
+
 @end
@@ -0,0 +1,111 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+#import <Foundation/Foundation.h>
+
+
+
+/**
+ *  The vertical placement of a section of `KITAssetsGridViewLayout`.
+ */
+typedef struct
+{
+    NSInteger numberOfItems;
+    NSInteger numberOfRows;
+    CGFloat top;        // origin of the header
+    CGFloat itemsTop;   // origin of the first row
+    CGFloat bottom;     // end of the footer
+} KITAssetsGridViewLayoutSection;
+
+/**
+ *  The sizes the vertical placement depends on.
+ */
+typedef struct
+{
+    NSInteger numberOfColumns;
+    CGFloat itemHeight;
+    CGFloat lineSpacing;
+    CGFloat headerHeight;
+    CGFloat footerHeight;
+    CGFloat sectionInsetTop;
+    CGFloat sectionInsetBottom;
+    BOOL showsFooterInLastSectionOnly;
+} KITAssetsGridViewLayoutMetrics;
+
+
+
+/**
+ *  The arithmetic of `KITAssetsGridViewLayout`, in plain C.
+ *
+ *  Every item has the same size, so sections are placed from their item counts alone and the items in a
+ *  band of content follow from a division. Nothing here depends on the number of items.
+ *
+ *  @param sections         The sections, with `numberOfItems` set; the other fields are filled in.
+ *  @param numberOfSections The number of sections.
+ *  @param metrics          The sizes of the layout.
+ *
+ *  @return The content height.
+ */
+CGFloat KITAssetsGridViewLayoutPlaceSections(KITAssetsGridViewLayoutSection *sections, NSInteger numberOfSections,
+                                            KITAssetsGridViewLayoutMetrics metrics);
+
+/**
+ *  Whether a section has a footer.
+ */
+BOOL KITAssetsGridViewLayoutShowsFooter(KITAssetsGridViewLayoutMetrics metrics, NSInteger section, NSInteger numberOfSections);
+
+/**
+ *  The section whose header or first row is at or above a vertical offset, in log n, or `NSNotFound` if
+ *  there are no sections.
+ */
+NSInteger KITAssetsGridViewLayoutSectionAtOffset(const KITAssetsGridViewLayoutSection *sections, NSInteger numberOfSections,
+                                                 CGFloat offset);
+
+/**
+ *  The items of a section whose rows overlap a vertical band.
+ *
+ *  @param section   The placed section.
+ *  @param metrics   The sizes of the layout.
+ *  @param minY      The top of the band.
+ *  @param maxY      The bottom of the band.
+ *  @param firstItem Receives the first item.
+ *  @param lastItem  Receives the last item.
+ *
+ *  @return `NO` if no row of the section overlaps the band.
+ */
+BOOL KITAssetsGridViewLayoutItemsInBand(const KITAssetsGridViewLayoutSection *section, KITAssetsGridViewLayoutMetrics metrics,
+                                        CGFloat minY, CGFloat maxY,
+                                        NSInteger *firstItem, NSInteger *lastItem);
+
+/**
+ *  The content offset that shows the end of the content, or the top when it is shorter than the viewport.
+ *
+ *  @param contentHeight  The content height.
+ *  @param viewportHeight The height of the scroll view's bounds.
+ *  @param insetTop       The top content inset.
+ *  @param insetBottom    The bottom content inset.
+ */
+CGFloat KITAssetsGridViewLayoutBottomOffset(CGFloat contentHeight, CGFloat viewportHeight, CGFloat insetTop, CGFloat insetBottom);
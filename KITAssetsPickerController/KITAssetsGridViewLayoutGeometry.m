@@ -0,0 +1,127 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+#import "KITAssetsGridViewLayoutGeometry.h"
+#include <math.h>
+
+
+
+#pragma mark - Sections
+
+CGFloat KITAssetsGridViewLayoutPlaceSections(KITAssetsGridViewLayoutSection *sections, NSInteger numberOfSections,
+                                            KITAssetsGridViewLayoutMetrics metrics)
+{
+    NSInteger numberOfColumns = MAX(1, metrics.numberOfColumns);
+    CGFloat y = 0;
+    
+    // one entry per section, nothing per item
+    for (NSInteger section = 0; section < numberOfSections; section++)
+    {
+        KITAssetsGridViewLayoutSection *info = &sections[section];
+        
+        info->numberOfRows  = (info->numberOfItems + numberOfColumns - 1) / numberOfColumns;
+        info->top           = y;
+        
+        y += metrics.headerHeight + metrics.sectionInsetTop;
+        info->itemsTop = y;
+        
+        if (info->numberOfRows > 0)
+            y += info->numberOfRows * metrics.itemHeight + (info->numberOfRows - 1) * metrics.lineSpacing;
+        
+        y += metrics.sectionInsetBottom;
+        
+        if (KITAssetsGridViewLayoutShowsFooter(metrics, section, numberOfSections))
+            y += metrics.footerHeight;
+        
+        info->bottom = y;
+    }
+    
+    return y;
+}
+
+BOOL KITAssetsGridViewLayoutShowsFooter(KITAssetsGridViewLayoutMetrics metrics, NSInteger section, NSInteger numberOfSections)
+{
+    return (metrics.footerHeight > 0 &&
+            (!metrics.showsFooterInLastSectionOnly || section == numberOfSections - 1));
+}
+
+NSInteger KITAssetsGridViewLayoutSectionAtOffset(const KITAssetsGridViewLayoutSection *sections, NSInteger numberOfSections,
+                                                 CGFloat offset)
+{
+    if (numberOfSections == 0)
+        return NSNotFound;
+    
+    NSInteger low = 0;
+    NSInteger high = numberOfSections - 1;
+    
+    while (low < high)
+    {
+        NSInteger mid = (low + high + 1) / 2;
+        
+        if (sections[mid].top <= offset)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+    
+    return low;
+}
+
+
+#pragma mark - Items
+
+BOOL KITAssetsGridViewLayoutItemsInBand(const KITAssetsGridViewLayoutSection *section, KITAssetsGridViewLayoutMetrics metrics,
+                                        CGFloat minY, CGFloat maxY,
+                                        NSInteger *firstItem, NSInteger *lastItem)
+{
+    NSInteger numberOfColumns = MAX(1, metrics.numberOfColumns);
+    CGFloat rowHeight = metrics.itemHeight + metrics.lineSpacing;
+    
+    if (section->numberOfRows == 0 || rowHeight <= 0 || maxY <= minY)
+        return NO;
+    
+    NSInteger firstRow = (NSInteger)floor((minY - section->itemsTop) / rowHeight);
+    NSInteger lastRow  = (NSInteger)floor((maxY - section->itemsTop) / rowHeight);
+    
+    firstRow = MAX(0, firstRow);
+    lastRow  = MIN(section->numberOfRows - 1, lastRow);
+    
+    if (firstRow > lastRow)
+        return NO;
+    
+    *firstItem = firstRow * numberOfColumns;
+    *lastItem  = MIN(section->numberOfItems - 1, (lastRow + 1) * numberOfColumns - 1);
+    
+    return YES;
+}
+
+
+#pragma mark - Content offset
+
+CGFloat KITAssetsGridViewLayoutBottomOffset(CGFloat contentHeight, CGFloat viewportHeight, CGFloat insetTop, CGFloat insetBottom)
+{
+    return MAX(-insetTop, contentHeight + insetBottom - viewportHeight);
+}
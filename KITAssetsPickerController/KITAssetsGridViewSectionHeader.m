@@ -0,0 +1,130 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import "KITAssetsPickerDefines.h"
+#import "KITAssetsGridViewSectionHeader.h"
+
+
+
+
+@interface KITAssetsGridViewSectionHeader ()
+
+@property (nonatomic, strong) UILabel *label;
+
+@end
+
+
+
+
+
+@implementation KITAssetsGridViewSectionHeader
+
+- (instancetype)initWithFrame:(CGRect)frame
+{
+    if (self = [super initWithFrame:frame])
+    {
+        [self setupViews];
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Setup
+
+- (void)setupViews
+{
+    UILabel *label = [UILabel new];
+    label.font = KITAssetsGridViewSectionHeaderFont;
+    label.textColor = KITAssetsGridViewSectionHeaderTextColor;
+    
+    self.label = label;
+    [self addSubview:self.label];
+}
+
+
+#pragma mark - Appearance
+
+- (UIFont *)font
+{
+    return self.label.font;
+}
+
+- (void)setFont:(UIFont *)font
+{
+    UIFont *labelFont = (font) ? font : KITAssetsGridViewSectionHeaderFont;
+    self.label.font = labelFont;
+}
+
+- (UIColor *)textColor
+{
+    return self.label.textColor;
+}
+
+- (void)setTextColor:(UIColor *)textColor
+{
+    UIColor *color = (textColor) ? textColor : KITAssetsGridViewSectionHeaderTextColor;
+    self.label.textColor = color;
+}
+
+
+#pragma mark - Layout
+
+- (void)layoutSubviews
+{
+    [super layoutSubviews];
+    self.label.frame = CGRectInset(self.bounds, 8, 0);
+}
+
+
+#pragma mark - Bind date
+
+- (void)bind:(NSDate *)date
+{
+    self.label.text = [self.class titleForDate:date];
+}
+
++ (NSString *)titleForDate:(NSDate *)date
+{
+    return (date) ? [[self dateFormatter] stringFromDate:date] : nil;
+}
+
++ (NSDateFormatter *)dateFormatter
+{
+    static NSDateFormatter *dateFormatter;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        dateFormatter = [NSDateFormatter new];
+        dateFormatter.dateStyle = NSDateFormatterMediumStyle;
+        dateFormatter.timeStyle = NSDateFormatterNoStyle;
+    });
+    
+    return dateFormatter;
+}
+
+@end
@@ -40,6 +40,12 @@
  */
 @property (nonatomic, assign) NSInteger pageIndex;
 
+/**
+ *  The number of pages ahead, in the direction the user is paging, whose images are loaded before they are shown.
+ *  `0` turns prefetching off. The default value is `KITAssetsPagePrefetchRadius`.
+ */
+@property (nonatomic, assign) NSUInteger prefetchRadius;
+
 
 /**
  *  @name Creating a Assets Page View Controller
@@ -26,8 +26,12 @@
 
 #import "KITAssetsPageViewController.h"
 #import "KITAssetsPageView.h"
+#import "KITAssetIndexMap.h"
+#import "KITAsyncAssetCollectionDataSource.h"
 #import "KITAssetItemViewController.h"
 #import "KITAssetScrollView.h"
+#import "KITAssetImagePrefetcher.h"
+#import "KITAssetsPickerDefines.h"
 #import "NSNumberFormatter+KITAssetsPickerController.h"
 #import "NSBundle+KITAssetsPickerController.h"
 #import "UIImage+KITAssetsPickerController.h"
@@ -36,6 +40,11 @@
 
 
 
+// the page shown, the ones on either side while paging and one being let go
+static const NSUInteger KITAssetsPageViewControllerReusePoolSize = 4;
+
+
+
 @interface KITAssetsPageViewController ()
 <UIPageViewControllerDataSource, UIPageViewControllerDelegate>
 
@@ -45,8 +54,19 @@
 @property (nonatomic, assign, getter = isStatusBarHidden) BOOL statusBarHidden;
 
 @property (nonatomic, copy) NSArray *assets;
+@property (nonatomic, weak) id<KITAssetCollectionDataSource> assetCollection;
+@property (nonatomic, strong) KITAssetIndexMap *assetIndexMap;
+
+@property (nonatomic, strong) id<KITAsyncAssetCollectionDataSource> pagedAssetCollection;
+@property (nonatomic, strong) NSMutableIndexSet *loadingIndexes;
 @property (nonatomic, strong, readonly) id<KITAssetDataSource> asset;
 
+@property (nonatomic, strong) KITAssetImagePrefetcher *prefetcher;
+@property (nonatomic, assign) NSInteger pagingDirection;
+
+@property (nonatomic, strong) NSMutableArray *reusableItemViewControllers;
+@property (nonatomic, strong) NSHashTable *pendingItemViewControllers;
+
 @property (nonatomic, strong) KITAssetsPageView *pageView;
 
 @end
@@ -59,6 +79,29 @@
 
 - (instancetype)initWithCollection:(id<NSFastEnumeration>)collection
 {
+    // one range request instead of one message per asset
+    if ([(id)collection conformsToProtocol:@protocol(KITAssetCollectionDataSource)])
+    {
+        id<KITAssetCollectionDataSource> assetCollection = (id<KITAssetCollectionDataSource>)collection;
+        
+        // paged collections are read page by page as the user gets to them
+        if ([assetCollection conformsToProtocol:@protocol(KITAsyncAssetCollectionDataSource)])
+        {
+            if ((self = [self initWithAssets:@[]]))
+            {
+                self.assetCollection        = assetCollection;
+                self.pagedAssetCollection   = (id<KITAsyncAssetCollectionDataSource>)assetCollection;
+            }
+            
+            return self;
+        }
+        
+        if ((self = [self initWithAssets:KITAssetCollectionObjectsInRange(assetCollection, NSMakeRange(0, assetCollection.count))]))
+            self.assetCollection = assetCollection;
+        
+        return self;
+    }
+    
     NSMutableArray *assets = [NSMutableArray new];
     
     for (id<KITAssetDataSource> asset in collection)
@@ -76,10 +119,16 @@
     if (self)
     {
         self.assets          = assets;
+        self.assetIndexMap   = [[KITAssetIndexMap alloc] initWithAssets:assets];
         self.dataSource      = self;
         self.delegate        = self;
         self.allowsSelection = NO;
         self.automaticallyAdjustsScrollViewInsets = NO;
+        self.prefetchRadius  = KITAssetsPagePrefetchRadius;
+        self.pagingDirection = 1;
+        self.reusableItemViewControllers = [NSMutableArray new];
+        self.pendingItemViewControllers  = [NSHashTable weakObjectsHashTable];
+        self.loadingIndexes  = [NSMutableIndexSet new];
     }
     
     return self;
@@ -95,6 +144,7 @@
 
 - (void)dealloc
 {
+    [NSObject cancelPreviousPerformRequestsWithTarget:self];
     [self removeNotificationObserver];
 }
 
@@ -128,7 +178,7 @@
 {
     NSNumberFormatter *nf = [NSNumberFormatter new];
 
-    NSInteger count = self.assets.count;
+    NSInteger count = [self numberOfAssets];
     self.title      = [NSString stringWithFormat:KITAssetsPickerLocalizedString(@"%@ of %@", nil),
                        [nf KITAssetsPickerStringFromAssetsCount:index],
                        [nf KITAssetsPickerStringFromAssetsCount:count]];
@@ -162,50 +212,189 @@
 
 - (NSInteger)pageIndex
 {
-    return [self.assets indexOfObject:self.asset];
+    return [self indexOfItemViewController:self.viewControllers.firstObject];
 }
 
 - (void)setPageIndex:(NSInteger)pageIndex
 {
-    NSInteger count = self.assets.count;
+    NSInteger count = [self numberOfAssets];
     
-    if (pageIndex >= 0 && pageIndex < count)
+    if (pageIndex >= 0 && pageIndex < count && ![self assetAtIndex:pageIndex])
     {
-        id<KITAssetDataSource> asset = [self.assets objectAtIndex:pageIndex];
+        __weak KITAssetsPageViewController *weakSelf = self;
         
-        KITAssetItemViewController *page = [KITAssetItemViewController assetItemViewControllerForAsset:asset];
-        page.allowsSelection = self.allowsSelection;
+        [self loadAssetAtIndex:pageIndex completionHandler:^{
+            if ([weakSelf assetAtIndex:pageIndex])
+                weakSelf.pageIndex = pageIndex;
+        }];
+    }
+    else if (pageIndex >= 0 && pageIndex < count)
+    {
+        KITAssetItemViewController *page = [self itemViewControllerAtIndex:pageIndex];
         
         [self setViewControllers:@[page]
                        direction:UIPageViewControllerNavigationDirectionForward
                         animated:NO
                       completion:NULL];
         
+        [self.pendingItemViewControllers removeAllObjects];
+        
         [self updateTitle:pageIndex + 1];
         [self updateToolbar];
+        [self prefetchAroundIndex:pageIndex];
     }
 }
 
 - (id<KITAssetDataSource> )asset
 {
-    return ((KITAssetItemViewController *)self.viewControllers[0]).asset;
+    return ((KITAssetItemViewController *)self.viewControllers.firstObject).asset;
+}
+
+
+#pragma mark - Assets
+
+- (NSInteger)numberOfAssets
+{
+    return (self.pagedAssetCollection) ? self.pagedAssetCollection.count : self.assets.count;
+}
+
+// nil for an index of a paged collection that is not loaded yet
+- (id<KITAssetDataSource>)assetAtIndex:(NSUInteger)index
+{
+    id<KITAsyncAssetCollectionDataSource> collection = self.pagedAssetCollection;
+    
+    if (!collection)
+        return self.assets[index];
+    
+    if (index >= collection.count || ![collection areObjectsLoadedInRange:NSMakeRange(index, 1)])
+        return nil;
+    
+    return [collection objectAtIndex:index];
+}
+
+- (NSInteger)indexOfItemViewController:(KITAssetItemViewController *)page
+{
+    if (!page)
+        return NSNotFound;
+    
+    // pages know their index, which paged collections have no map for
+    return (page.assetIndex != NSNotFound) ? page.assetIndex : [self.assetIndexMap indexOfAsset:page.asset];
+}
+
+- (void)loadAssetAtIndex:(NSUInteger)index completionHandler:(void (^)(void))handler
+{
+    id<KITAsyncAssetCollectionDataSource> collection = self.pagedAssetCollection;
+    
+    if (!collection || [self.loadingIndexes containsIndex:index])
+        return;
+    
+    [self.loadingIndexes addIndex:index];
+    
+    __weak KITAssetsPageViewController *weakSelf = self;
+    
+    [collection loadObjectsInRange:NSMakeRange(index, 1) completionHandler:^(NSError *error) {
+        [weakSelf.loadingIndexes removeIndex:index];
+        handler();
+    }];
+}
+
+- (void)loadNeighbourAtIndex:(NSUInteger)index
+{
+    __weak KITAssetsPageViewController *weakSelf = self;
+    
+    [self loadAssetAtIndex:index completionHandler:^{
+        if ([weakSelf assetAtIndex:index])
+            [weakSelf reloadNeighbours];
+    }];
+}
+
+// the page view controller only asks for neighbours again once it is given its pages anew, which must wait for paging to stop
+- (void)reloadNeighbours
+{
+    UIViewController *page = self.viewControllers.firstObject;
+    
+    if (!page)
+        return;
+    
+    for (UIView *view in self.view.subviews)
+    {
+        if ([view isKindOfClass:UIScrollView.class] && (((UIScrollView *)view).isDragging || ((UIScrollView *)view).isDecelerating))
+        {
+            [self performSelector:@selector(reloadNeighbours) withObject:nil afterDelay:0.3];
+            return;
+        }
+    }
+    
+    [self setViewControllers:@[page]
+                   direction:UIPageViewControllerNavigationDirectionForward
+                    animated:NO
+                  completion:NULL];
 }
 
 
 #pragma mark - Page view controller data source
 
-- (UIViewController *)pageViewController:(UIPageViewController *)pageViewController viewControllerBeforeViewController:(UIViewController *)viewController
+- (KITAssetItemViewController *)itemViewControllerAtIndex:(NSUInteger)index
+{
+    KITAssetItemViewController *page = [self dequeueItemViewControllerForAsset:[self assetAtIndex:index]];
+    page.allowsSelection = self.allowsSelection;
+    page.assetCollection = self.assetCollection;
+    page.assetIndex      = index;
+    page.prefetcher      = self.prefetcher;
+    
+    return page;
+}
+
+- (KITAssetItemViewController *)dequeueItemViewControllerForAsset:(id<KITAssetDataSource>)asset
 {
-    id<KITAssetDataSource> asset = ((KITAssetItemViewController *)viewController).asset;
-    NSInteger index = [self.assets indexOfObject:asset];
+    KITAssetItemViewController *page = nil;
+    
+    for (KITAssetItemViewController *reusablePage in self.reusableItemViewControllers)
+    {
+        if ([self isItemViewControllerReusable:reusablePage])
+        {
+            page = reusablePage;
+            [page prepareForReuseWithAsset:asset];
+            break;
+        }
+    }
     
-    if (index > 0)
+    if (!page)
     {
-        id<KITAssetDataSource> beforeAsset = [self.assets objectAtIndex:(index - 1)];
-        KITAssetItemViewController *page = [KITAssetItemViewController assetItemViewControllerForAsset:beforeAsset];
-        page.allowsSelection = self.allowsSelection;
+        page = [KITAssetItemViewController assetItemViewControllerForAsset:asset];
         
-        return page;
+        if (self.reusableItemViewControllers.count < KITAssetsPageViewControllerReusePoolSize)
+            [self.reusableItemViewControllers addObject:page];
+    }
+    
+    [self.pendingItemViewControllers addObject:page];
+    
+    return page;
+}
+
+// the scroll style keeps the pages on either side of the shown one without making them children,
+// so a controller is only free when it is neither shown, handed out since paging started, nor a neighbour
+- (BOOL)isItemViewControllerReusable:(KITAssetItemViewController *)page
+{
+    if ([self.viewControllers containsObject:page] || [self.pendingItemViewControllers containsObject:page])
+        return NO;
+    
+    NSInteger pageIndex = self.pageIndex;
+    NSInteger index     = [self indexOfItemViewController:page];
+    
+    if (pageIndex == NSNotFound || index == NSNotFound)
+        return (pageIndex == NSNotFound);
+    
+    return (ABS(index - pageIndex) > 1);
+}
+
+- (UIViewController *)pageViewController:(UIPageViewController *)pageViewController viewControllerBeforeViewController:(UIViewController *)viewController
+{
+    NSInteger index = [self indexOfItemViewController:(KITAssetItemViewController *)viewController];
+    
+    if (index != NSNotFound && index > 0)
+    {
+        return [self neighbourViewControllerAtIndex:index - 1];
     }
 
     return nil;
@@ -213,22 +402,28 @@
 
 - (UIViewController *)pageViewController:(UIPageViewController *)pageViewController viewControllerAfterViewController:(UIViewController *)viewController
 {
-    id<KITAssetDataSource> asset  = ((KITAssetItemViewController *)viewController).asset;
-    NSInteger index = [self.assets indexOfObject:asset];
-    NSInteger count = self.assets.count;
+    NSInteger index = [self indexOfItemViewController:(KITAssetItemViewController *)viewController];
+    NSInteger count = [self numberOfAssets];
     
-    if (index < count - 1)
+    if (index != NSNotFound && index < count - 1)
     {
-        id<KITAssetDataSource> afterAsset = [self.assets objectAtIndex:(index + 1)];
-        KITAssetItemViewController *page = [KITAssetItemViewController assetItemViewControllerForAsset:afterAsset];
-        page.allowsSelection = self.allowsSelection;
-        
-        return page;
+        return [self neighbourViewControllerAtIndex:index + 1];
     }
     
     return nil;
 }
 
+// paging stops at a page that is not loaded until it is
+- (UIViewController *)neighbourViewControllerAtIndex:(NSUInteger)index
+{
+    if ([self assetAtIndex:index])
+        return [self itemViewControllerAtIndex:index];
+    
+    [self loadNeighbourAtIndex:index];
+    
+    return nil;
+}
+
 
 #pragma mark - Page view controller delegate
 
@@ -237,16 +432,70 @@
     if (completed)
     {
         KITAssetItemViewController *vc = (KITAssetItemViewController *)pageViewController.viewControllers[0];
-        NSInteger index = [self.assets indexOfObject:vc.asset] + 1;
+        NSInteger index = [self indexOfItemViewController:vc] + 1;
         
         [self updateTitle:index];
         [self updateToolbar];
     }
+    
+    [self.pendingItemViewControllers removeAllObjects];
+    [self prefetchAroundIndex:self.pageIndex];
 }
 
 - (void)pageViewController:(UIPageViewController *)pageViewController willTransitionToViewControllers:(NSArray *)pendingViewControllers
 {
     [self.navigationController setToolbarHidden:YES animated:YES];
+    
+    KITAssetItemViewController *vc = (KITAssetItemViewController *)pendingViewControllers.firstObject;
+    NSInteger index = [self indexOfItemViewController:vc];
+    NSInteger pageIndex = self.pageIndex;
+    
+    // turning back cancels the loads ahead before the page settles
+    if (vc && index != pageIndex)
+    {
+        self.pagingDirection = (index > pageIndex) ? 1 : -1;
+        [self prefetchAroundIndex:index];
+    }
+}
+
+
+#pragma mark - Prefetching
+
+- (KITAssetImagePrefetcher *)prefetcher
+{
+    if (!_prefetcher)
+    {
+        UIScreen *screen            = UIScreen.mainScreen;
+        CGFloat scale               = screen.scale;
+        CGFloat maximumPixelSize    = MAX(CGRectGetWidth(screen.bounds), CGRectGetHeight(screen.bounds)) * scale;
+        
+        // the size the pages decode to, so a prefetched image can be shown as is
+        _prefetcher = [[KITAssetImagePrefetcher alloc] initWithMaximumPixelSize:maximumPixelSize];
+    }
+    
+    return _prefetcher;
+}
+
+- (void)prefetchAroundIndex:(NSInteger)index
+{
+    NSInteger count = [self numberOfAssets];
+    NSMutableArray *assets = [NSMutableArray new];
+    
+    if (index == NSNotFound)
+        return;
+    
+    for (NSInteger offset = 1; offset <= (NSInteger)self.prefetchRadius; offset++)
+    {
+        NSInteger neighbourIndex = index + offset * self.pagingDirection;
+        id<KITAssetDataSource> asset = (neighbourIndex >= 0 && neighbourIndex < count) ? [self assetAtIndex:neighbourIndex] : nil;
+        
+        if (!asset)
+            break;
+        
+        [assets addObject:asset];
+    }
+    
+    [self.prefetcher prefetchAssets:assets];
 }
 
 
@@ -28,6 +28,7 @@
 #import <UIKit/UIKit.h>
 #import "KITAssetDataSource.h"
 #import "KITAssetCollectionDataSource.h"
+#import "KITAssetConstraints.h"
 #import "KITCustomAssetPickerController.h"
 
 @protocol KITAssetsPickerControllerDelegate;
@@ -89,6 +90,61 @@
  */
 @property (nonatomic, assign) BOOL showsSelectionIndex;
 
+/**
+ *  Determines whether or not the grid view uses flattened cells.
+ *
+ *  Flattened cells draw the thumbnail and the disabled, highlighted and selected states into two layers
+ *  laid out with frames, instead of a tree of about eight views wired with Auto Layout. This noticeably
+ *  reduces compositing and layout work on dense grids. Appearance proxies of `KITAssetsGridSelectedView`
+ *  do not apply to flattened cells; they use the cell's `tintColor` and the default selection style.
+ *
+ *  The default value is `NO`.
+ */
+@property (nonatomic, assign) BOOL usesFlattenedGridCells;
+
+/**
+ *  Determines whether or not the grid view groups assets into sections by day.
+ *
+ *  Sections are built from `creationDate` of `KITAssetDataSource` the first time an album is shown; the grid
+ *  shows a single section until they are ready. Paged albums are grouped once every page has been loaded.
+ *  Assets without a date join the section before them. Assets are expected to be ordered by date.
+ *
+ *  The default value is `NO`.
+ */
+@property (nonatomic, assign) BOOL groupsAssetsByDate;
+
+/**
+ *  Determines whether or not the grid view can be pinched to show more or fewer columns.
+ *
+ *  Each pinch steps one column between 3 and 12 columns, following the fingers interactively.
+ *  It has no effect when the delegate provides its own collection view layout.
+ *
+ *  The default value is `NO`.
+ */
+@property (nonatomic, assign) BOOL allowsPinchToZoomGrid;
+
+/**
+ *  Determines whether or not long albums show a scrubber on the trailing edge of the grid.
+ *
+ *  Dragging the scrubber jumps straight to the matching position, showing the date of the landing section
+ *  when `groupsAssetsByDate` is enabled. Thumbnails are only requested for where the drag ends.
+ *  The scrubber appears when the grid is at least five screens long.
+ *
+ *  The default value is `NO`.
+ */
+@property (nonatomic, assign) BOOL showsScrubber;
+
+/**
+ *  The rules assets have to meet to be enabled for selection, such as a minimum print resolution.
+ *
+ *  Constraints are evaluated in bulk on a background queue the first time an album is shown, and the
+ *  result is reused by the grid and the page view. Prefer them over `assetsPickerController:shouldEnableAsset:`
+ *  for rules that only depend on the asset's size or type; when both are set, an asset has to pass both.
+ *
+ *  The default value is `nil`.
+ */
+@property (nonatomic, copy) KITAssetConstraints *assetConstraints;
+
 
 /**
  *  @name Managing Selections
@@ -34,6 +34,9 @@
 #import "KITAssetScrollView.h"
 #import "KITAssetsPageViewController.h"
 #import "KITAssetsViewControllerTransition.h"
+#import "KITAssetsPickerPrewarmer.h"
+#import "KITAssetEnablementMap.h"
+#import "KITAssetCollectionChangeSet.h"
 #import "NSBundle+KITAssetsPickerController.h"
 #import "UIImage+KITAssetsPickerController.h"
 #import "NSNumberFormatter+KITAssetsPickerController.h"
@@ -55,6 +58,9 @@ NSString * const KITAssetsPickerDidDeselectAssetNotification = @"KITAssetsPicker
 @property (nonatomic, assign) CGSize assetCollectionThumbnailSize;
 @property (nonatomic, assign) CGSize assetThumbnailSize;
 
+@property (nonatomic, strong) NSMapTable *enablementMaps;
+@property (nonatomic, strong) NSMapTable *enablementMapBuilds;
+
 @end
 
 
@@ -72,6 +78,14 @@ NSString * const KITAssetsPickerDidDeselectAssetNotification = @"KITAssetsPicker
         _showsEmptyAlbums                   = YES;
         _showsNumberOfAssets                = YES;
         _showsSelectionIndex                = NO;
+        _usesFlattenedGridCells             = NO;
+        _groupsAssetsByDate                 = NO;
+        _allowsPinchToZoomGrid              = NO;
+        _showsScrubber                      = NO;
+        _enablementMaps                     = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                                                    valueOptions:NSPointerFunctionsStrongMemory];
+        _enablementMapBuilds                = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                                                    valueOptions:NSPointerFunctionsStrongMemory];
         
         self.preferredContentSize           = KITAssetsPickerPopoverContentSize;
     }
@@ -86,11 +100,14 @@ NSString * const KITAssetsPickerDidDeselectAssetNotification = @"KITAssetsPicker
     [self setupEmptyViewController];
     [self checkAssetsCount];
     [self addKeyValueObserver];
+    [self addNotificationObserver];
+    [KITAssetsPickerPrewarmer prewarmResourcesWhenIdle];
 }
 
 - (void)dealloc
 {
     [self removeKeyValueObserver];
+    [self removeNotificationObserver];
 }
 
 - (UIViewController *)childViewControllerForStatusBarStyle
@@ -291,6 +308,29 @@ NSString * const KITAssetsPickerDidDeselectAssetNotification = @"KITAssetsPicker
 }
 
 
+#pragma mark - Notifications
+
+- (void)addNotificationObserver
+{
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(assetCollectionDidChange:)
+                                                 name:KITAssetCollectionDidChangeNotification
+                                               object:nil];
+}
+
+- (void)removeNotificationObserver
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self name:KITAssetCollectionDidChangeNotification object:nil];
+}
+
+- (void)assetCollectionDidChange:(NSNotification *)notification
+{
+    // indexes of the map no longer match the collection
+    [self.enablementMaps removeObjectForKey:notification.object];
+    [self.enablementMapBuilds removeObjectForKey:notification.object];
+}
+
+
 #pragma mark - Toggle button
 
 - (void)toggleDoneButton
@@ -398,6 +438,75 @@ NSString * const KITAssetsPickerDidDeselectAssetNotification = @"KITAssetsPicker
 }
 
 
+#pragma mark - Enabling assets
+
+- (void)setAssetConstraints:(KITAssetConstraints *)assetConstraints
+{
+    _assetConstraints = [assetConstraints copy];
+    
+    [self.enablementMaps removeAllObjects];
+    [self.enablementMapBuilds removeAllObjects];
+}
+
+- (BOOL)shouldEnableAsset:(id<KITAssetDataSource>)asset atIndex:(NSUInteger)index inAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+{
+    if (self.assetConstraints && ![self asset:asset atIndex:index inAssetCollection:assetCollection satisfiesConstraints:self.assetConstraints])
+        return NO;
+    
+    if ([self.delegate respondsToSelector:@selector(assetsPickerController:shouldEnableAsset:)])
+        return [self.delegate assetsPickerController:self shouldEnableAsset:asset];
+    else
+        return YES;
+}
+
+- (BOOL)asset:(id<KITAssetDataSource>)asset atIndex:(NSUInteger)index inAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection satisfiesConstraints:(KITAssetConstraints *)constraints
+{
+    KITAssetEnablementMap *enablementMap = (assetCollection) ? [self.enablementMaps objectForKey:assetCollection] : nil;
+    
+    if (enablementMap && index < enablementMap.count)
+        return [enablementMap isAssetEnabledAtIndex:index];
+    
+    if (assetCollection && !enablementMap)
+        [self buildEnablementMapIfNeededForAssetCollection:assetCollection];
+    
+    // the map gives the same answer once it is ready
+    return [constraints isSatisfiedByAsset:asset];
+}
+
+- (void)buildEnablementMapIfNeededForAssetCollection:(id<KITAssetCollectionDataSource>)assetCollection
+{
+    if ([self.enablementMapBuilds objectForKey:assetCollection])
+        return;
+    
+    // a build is only kept if neither the collection nor the constraints changed meanwhile
+    NSObject *build = [NSObject new];
+    [self.enablementMapBuilds setObject:build forKey:assetCollection];
+    
+    __weak KITAssetsPickerController *weakSelf = self;
+    
+    [KITAssetEnablementMap buildEnablementMapForAssetCollection:assetCollection
+                                                    constraints:self.assetConstraints
+                                              completionHandler:^(KITAssetEnablementMap *enablementMap) {
+                                                  if ([weakSelf.enablementMapBuilds objectForKey:assetCollection] == build)
+                                                      [weakSelf.enablementMaps setObject:enablementMap forKey:assetCollection];
+                                              }];
+}
+
+
+- (void)assetCollectionDidLoadAssets:(id<KITAssetCollectionDataSource>)assetCollection
+{
+    // paged collections post no change notification when a page lands, so a map built before the
+    // whole collection was loaded covers none of it; drop it and let the next check rebuild it
+    KITAssetEnablementMap *enablementMap = [self.enablementMaps objectForKey:assetCollection];
+    
+    if (enablementMap && enablementMap.count >= assetCollection.count)
+        return;
+    
+    [self.enablementMaps removeObjectForKey:assetCollection];
+    [self.enablementMapBuilds removeObjectForKey:assetCollection];
+}
+
+
 #pragma mark - Image target size
 
 - (CGSize)imageSizeForContainerSize:(CGSize)size
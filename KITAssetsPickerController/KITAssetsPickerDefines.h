@@ -60,5 +60,25 @@
 #define KITAssetsGridViewFooterFont              [UIFont preferredFontForTextStyle:UIFontTextStyleBody]
 #define KITAssetsGridViewFooterTextColor         [UIColor darkTextColor]
 
+#define KITAssetsGridViewSectionHeaderFont       [UIFont preferredFontForTextStyle:UIFontTextStyleHeadline]
+#define KITAssetsGridViewSectionHeaderTextColor  [UIColor darkTextColor]
+#define KITAssetsGridViewSectionHeaderHeight     44.0f
+
+#define KITAssetsGridViewMinimumNumberOfColumns  3
+#define KITAssetsGridViewMaximumNumberOfColumns  12
+
+#define KITAssetsGridScrubberFont                [UIFont preferredFontForTextStyle:UIFontTextStyleFootnote]
+#define KITAssetsGridScrubberTextColor           [UIColor whiteColor]
+#define KITAssetsGridScrubberWidth               44.0f
+#define KITAssetsGridScrubberMinimumNumberOfScreens 5
+
+#define KITAssetTiledImageViewMinimumPixelSize   8192.0f
+#define KITAssetTiledImageViewTileSize           256.0f
+#define KITAssetTiledImageViewMaximumLevelBytes  (64 * 1024 * 1024)
+#define KITAssetTiledImageViewCacheBytes         (96 * 1024 * 1024)
+
+#define KITAssetsPagePrefetchRadius              2
+#define KITAssetsPagePrefetchCacheBytes          (48 * 1024 * 1024)
+
 #define KITAssetsPageViewPageBackgroundColor         [UIColor whiteColor]
 #define KITAssetsPageViewFullscreenBackgroundColor   [UIColor blackColor]
\ No newline at end of file
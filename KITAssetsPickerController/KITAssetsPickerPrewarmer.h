@@ -0,0 +1,65 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <Foundation/Foundation.h>
+
+
+
+/**
+ *  Defers start-up work to idle run loop time, so it does not compete with the first frames.
+ *
+ *  Each pass is bracketed by kdebug signposts (code 0x4B49 for resources, 0x4B4A for cells)
+ *  on iOS 10 and later, so it shows up as a region in the Points of Interest instrument.
+ */
+@interface KITAssetsPickerPrewarmer : NSObject
+
+/**
+ *  Loads the bundle images and renders the overlay bitmaps used by grid cells, once per process,
+ *  the next time the main run loop is about to wait.
+ */
++ (void)prewarmResourcesWhenIdle;
+
+/**
+ *  Runs the block once, the next time the main run loop is about to wait.
+ *
+ *  @param code  The signpost code identifying the work in traces.
+ *  @param block The work to perform.
+ */
++ (void)performWhenIdleWithSignpostCode:(uint32_t)code block:(dispatch_block_t)block;
+
+/**
+ *  Marks the start and the end of a region in traces, on iOS 10 and later.
+ */
++ (void)signpostStart:(uint32_t)code;
++ (void)signpostEnd:(uint32_t)code;
+
+@end
+
+
+extern const uint32_t KITAssetsPickerPrewarmResourcesSignpostCode;
+extern const uint32_t KITAssetsPickerPrewarmCellsSignpostCode;
+extern const uint32_t KITAssetsPickerOpenGridSignpostCode;
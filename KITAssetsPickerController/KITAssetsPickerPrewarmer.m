@@ -0,0 +1,112 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <UIKit/UIKit.h>
+#import <sys/kdebug_signpost.h>
+#import "KITAssetsPickerPrewarmer.h"
+#import "KITAssetOverlayImageCache.h"
+#import "UIImage+KITAssetsPickerController.h"
+
+
+
+
+const uint32_t KITAssetsPickerPrewarmResourcesSignpostCode = 0x4B49;
+const uint32_t KITAssetsPickerPrewarmCellsSignpostCode = 0x4B4A;
+const uint32_t KITAssetsPickerOpenGridSignpostCode = 0x4B4B;
+
+
+
+@implementation KITAssetsPickerPrewarmer
+
++ (void)prewarmResourcesWhenIdle
+{
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        [self performWhenIdleWithSignpostCode:KITAssetsPickerPrewarmResourcesSignpostCode block:^{
+            [self prewarmResources];
+        }];
+    });
+}
+
++ (void)prewarmResources
+{
+    for (NSString *name in @[@"GridDisabledAsset", @"Checkmark", @"CheckmarkShadow", @"GridGradient", @"GridEmptyAlbum", @"DisclosureArrow"])
+        [UIImage KITAssetsPickerImageNamed:name];
+    
+    // the checkmark and the first few selection indexes are what a user sees first
+    KITAssetOverlayImageCache *cache = [KITAssetOverlayImageCache sharedCache];
+    CGFloat scale = UIScreen.mainScreen.scale;
+    
+    [cache overlayImageForState:KITAssetOverlayStateSelected size:CGSizeZero scale:scale tintColor:nil selectionIndex:0 attributes:nil];
+    
+    for (NSUInteger index = 0; index < 10; index++)
+        [cache overlayImageForState:KITAssetOverlayStateSelected | KITAssetOverlayStateSelectionIndex
+                               size:CGSizeZero
+                              scale:scale
+                          tintColor:nil
+                     selectionIndex:index
+                         attributes:nil];
+}
+
+
+#pragma mark - Idle run loop
+
++ (void)performWhenIdleWithSignpostCode:(uint32_t)code block:(dispatch_block_t)block
+{
+    CFRunLoopObserverRef observer =
+    CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault, kCFRunLoopBeforeWaiting, false, 0, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+        [self signpostStart:code];
+        block();
+        [self signpostEnd:code];
+    });
+    
+    CFRunLoopAddObserver(CFRunLoopGetMain(), observer, kCFRunLoopDefaultMode);
+    CFRelease(observer);
+}
+
+
+#pragma mark - Signposts
+
++ (BOOL)canSignpost
+{
+    return ([[[UIDevice currentDevice] systemVersion] floatValue] >= 10);
+}
+
++ (void)signpostStart:(uint32_t)code
+{
+    if ([self canSignpost])
+        kdebug_signpost_start(code, 0, 0, 0, 0);
+}
+
++ (void)signpostEnd:(uint32_t)code
+{
+    if ([self canSignpost])
+        kdebug_signpost_end(code, 0, 0, 0, 0);
+}
+
+@end
@@ -0,0 +1,73 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "KITAssetCollectionDataSource.h"
+
+
+
+/**
+ *  An asset collection that loads its assets in pages, such as a remote album listing.
+ *
+ *  `count` is the number of assets known so far, loaded or not. The grid shows placeholders for indexes that are
+ *  not loaded yet, asks for the pages the user scrolls toward, and inserts the assets appended by `loadMoreObjectsWithCompletionHandler:`
+ *  with batch updates instead of reloading. `objectAtIndex:` and the range methods are only called for loaded indexes.
+ *
+ *  All methods are called on the main thread; completion handlers must be called on the main thread too.
+ */
+@protocol KITAsyncAssetCollectionDataSource <KITAssetCollectionDataSource>
+
+/**
+ *  Whether every object in a range has been loaded
+ *
+ *  @param range The range, within `count`
+ */
+- (BOOL)areObjectsLoadedInRange:(NSRange)range;
+
+/**
+ *  Loads the pages covering a range of known indexes
+ *
+ *  @param range   The range, within `count`
+ *  @param handler Called once the objects are loaded or loading failed
+ */
+- (void)loadObjectsInRange:(NSRange)range completionHandler:(void (^)(NSError *error))handler;
+
+/**
+ *  Whether there are objects beyond `count`, for collections whose total is unknown or growing
+ */
+- (BOOL)hasMoreObjects;
+
+/**
+ *  Loads the next page after the last known object and appends it
+ *
+ *  `count` must already include the new objects when the handler is called.
+ *
+ *  @param handler Called with the number of objects appended, or an error
+ */
+- (void)loadMoreObjectsWithCompletionHandler:(void (^)(NSUInteger numberOfNewObjects, NSError *error))handler;
+
+@end
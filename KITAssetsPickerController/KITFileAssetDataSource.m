@@ -0,0 +1,180 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#import <ImageIO/ImageIO.h>
+#import <errno.h>
+#import <MobileCoreServices/MobileCoreServices.h>
+#import "KITFileAssetDataSource.h"
+#import "KITAssetDataRange.h"
+
+
+
+@interface KITFileAssetDataSource ()
+
+@property (nonatomic, copy, readwrite) NSURL *fileURL;
+
+@property (nonatomic, assign) CGSize pixelSize;
+@property (nonatomic, copy) NSString *mimeType;
+@property (nonatomic, strong) NSDate *creationDate;
+
+@end
+
+
+
+
+
+@implementation KITFileAssetDataSource
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL
+{
+    if (self = [super init])
+    {
+        _fileURL = [fileURL copy];
+        [self readProperties];
+    }
+    
+    return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+    return [self initWithFileURL:[aDecoder decodeObjectForKey:@"fileURL"]];
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [aCoder encodeObject:self.fileURL forKey:@"fileURL"];
+}
+
+- (BOOL)isEqual:(id)object
+{
+    return ([object isKindOfClass:[KITFileAssetDataSource class]] && [((KITFileAssetDataSource *)object).fileURL isEqual:self.fileURL]);
+}
+
+- (NSUInteger)hash
+{
+    return self.fileURL.hash;
+}
+
+
+#pragma mark - Properties
+
+// ImageIO only reads the header for these
+- (void)readProperties
+{
+    CGImageSourceRef source = CGImageSourceCreateWithURL((__bridge CFURLRef)self.fileURL, NULL);
+    
+    if (source)
+    {
+        NSDictionary *properties = CFBridgingRelease(CGImageSourceCopyPropertiesAtIndex(source, 0, NULL));
+        NSInteger orientation = [properties[(__bridge NSString *)kCGImagePropertyOrientation] integerValue];
+        
+        CGFloat width   = [properties[(__bridge NSString *)kCGImagePropertyPixelWidth] doubleValue];
+        CGFloat height  = [properties[(__bridge NSString *)kCGImagePropertyPixelHeight] doubleValue];
+        
+        // orientations 5 to 8 are rotated by a quarter turn
+        self.pixelSize = (orientation >= 5) ? CGSizeMake(height, width) : CGSizeMake(width, height);
+        
+        CFStringRef type = CGImageSourceGetType(source);
+        
+        if (type)
+            self.mimeType = CFBridgingRelease(UTTypeCopyPreferredTagWithClass(type, kUTTagClassMIMEType));
+        
+        CFRelease(source);
+    }
+    
+    NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:self.fileURL.path error:NULL];
+    self.creationDate = attributes.fileCreationDate;
+}
+
+- (CGFloat)pixelWidth
+{
+    return self.pixelSize.width;
+}
+
+- (CGFloat)pixelHeight
+{
+    return self.pixelSize.height;
+}
+
+
+#pragma mark - Data
+
++ (dispatch_queue_t)readQueue
+{
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("ly.kite.KITAssetsPickerController.file", DISPATCH_QUEUE_CONCURRENT);
+    });
+    
+    return queue;
+}
+
+- (void)dataLengthWithCompletionHandler:(void (^)(long long, NSError *))handler
+{
+    dispatch_async([self.class readQueue], ^{
+        NSError *error = nil;
+        NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:self.fileURL.path error:&error];
+        
+        handler((attributes) ? (long long)attributes.fileSize : -1, error);
+    });
+}
+
+- (void)dataWithCompletionHandler:(void (^)(NSData *, NSError *))handler
+{
+    dispatch_async([self.class readQueue], ^{
+        NSError *error = nil;
+        
+        // mapped, so pages are only read in as they are touched
+        NSData *data = [NSData dataWithContentsOfURL:self.fileURL options:NSDataReadingMappedIfSafe error:&error];
+        
+        handler(data, error);
+    });
+}
+
+- (void)dataInRange:(NSRange)range completionHandler:(void (^)(NSData *, NSError *))handler
+{
+    dispatch_async([self.class readQueue], ^{
+        void *bytes = malloc(MAX(range.length, 1));
+        long long length = KITAssetDataRangeReadFile(self.fileURL.fileSystemRepresentation, range.location, range.length, bytes);
+        
+        if (length < 0)
+        {
+            NSError *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{NSURLErrorKey : self.fileURL}];
+            free(bytes);
+            
+            handler(nil, error);
+            return;
+        }
+        
+        handler([NSData dataWithBytesNoCopy:bytes length:(NSUInteger)length freeWhenDone:YES], nil);
+    });
+}
+
+@end
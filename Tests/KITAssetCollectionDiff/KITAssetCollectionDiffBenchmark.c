@@ -0,0 +1,135 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "KITAssetCollectionDiff.h"
+
+
+
+static const int KITBenchmarkIterations = 5;
+
+
+
+static double KITBenchmarkNow(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// a library of unique assets where about one in a hundred is removed, added or moved, as after a sync
+static void KITBenchmarkRun(NSUInteger count)
+{
+    NSUInteger *from        = malloc(count * sizeof(NSUInteger));
+    NSUInteger *to          = malloc(count * 2 * sizeof(NSUInteger));
+    NSUInteger *fromMatches = malloc(count * sizeof(NSUInteger));
+    NSUInteger *toMatches   = malloc(count * 2 * sizeof(NSUInteger));
+    BOOL *stays             = malloc(count * 2 * sizeof(BOOL));
+    NSUInteger toCount      = 0;
+    NSUInteger newSymbol    = count;
+    
+    srand(1);
+    
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        from[i] = i;
+        
+        switch (rand() % 300)
+        {
+            case 0:
+                break;
+            case 1:
+                to[toCount++] = newSymbol++;
+                to[toCount++] = i;
+                break;
+            case 2:
+                // swapped with its neighbour, one move each time
+                if (toCount > 0)
+                {
+                    to[toCount] = to[toCount - 1];
+                    to[toCount - 1] = i;
+                }
+                else
+                {
+                    to[toCount] = i;
+                }
+                
+                toCount++;
+                break;
+            default:
+                to[toCount++] = i;
+                break;
+        }
+    }
+    
+    // warm up caches and the allocator
+    KITAssetCollectionDiffMatch(from, count, to, toCount, newSymbol, fromMatches, toMatches);
+    KITAssetCollectionDiffStays(toMatches, toCount, stays);
+    
+    double best = 1e9;
+    
+    for (int i = 0; i < KITBenchmarkIterations; i++)
+    {
+        double start = KITBenchmarkNow();
+        
+        KITAssetCollectionDiffMatch(from, count, to, toCount, newSymbol, fromMatches, toMatches);
+        KITAssetCollectionDiffStays(toMatches, toCount, stays);
+        
+        double elapsed = KITBenchmarkNow() - start;
+        best = (elapsed < best) ? elapsed : best;
+    }
+    
+    NSUInteger numberOfMoves = 0;
+    
+    for (NSUInteger j = 0; j < toCount; j++)
+        numberOfMoves += (toMatches[j] != NSNotFound && !stays[j]);
+    
+    printf("%8lu -> %8lu assets  %6lu moves  %8.2f ms  %8.1f M assets/s\n",
+           count, toCount, numberOfMoves, best * 1e3, (count + toCount) / best / 1e6);
+    
+    free(from);
+    free(to);
+    free(fromMatches);
+    free(toMatches);
+    free(stays);
+}
+
+int main(void)
+{
+    static const NSUInteger counts[] = {1000, 10000, 100000, 1000000};
+    
+    printf("symbols only; assigning them with isEqual: and hash is not measured here\n");
+    
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+        KITBenchmarkRun(counts[i]);
+    
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,330 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "KITAssetCollectionDiff.h"
+
+
+
+#pragma mark - Helpers
+
+static int failures = 0;
+
+#define KITExpect(condition, ...) \
+    do { if (!(condition)) { failures++; printf("FAIL %s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); } } while (0)
+
+typedef struct
+{
+    NSUInteger *fromMatches;
+    NSUInteger *toMatches;
+    BOOL *stays;
+} KITDiff;
+
+static KITDiff KITDiffCreate(const NSUInteger *from, NSUInteger fromCount, const NSUInteger *to, NSUInteger toCount, NSUInteger numberOfSymbols)
+{
+    KITDiff diff;
+    diff.fromMatches    = malloc(MAX(fromCount, 1) * sizeof(NSUInteger));
+    diff.toMatches      = malloc(MAX(toCount, 1) * sizeof(NSUInteger));
+    diff.stays          = malloc(MAX(toCount, 1) * sizeof(BOOL));
+    
+    BOOL matched    = KITAssetCollectionDiffMatch(from, fromCount, to, toCount, numberOfSymbols, diff.fromMatches, diff.toMatches);
+    BOOL stayed     = KITAssetCollectionDiffStays(diff.toMatches, toCount, diff.stays);
+    
+    KITExpect(matched && stayed, "the diff of %lu -> %lu symbols failed", fromCount, toCount);
+    
+    return diff;
+}
+
+static void KITDiffFree(KITDiff diff)
+{
+    free(diff.fromMatches);
+    free(diff.toMatches);
+    free(diff.stays);
+}
+
+static NSUInteger KITCountOf(NSUInteger symbol, const NSUInteger *symbols, NSUInteger count)
+{
+    NSUInteger occurrences = 0;
+    
+    for (NSUInteger i = 0; i < count; i++)
+        occurrences += (symbols[i] == symbol);
+    
+    return occurrences;
+}
+
+// the longest strictly increasing run of old indexes, the quadratic way
+static NSUInteger KITReferenceLongestRun(const NSUInteger *toMatches, NSUInteger toCount)
+{
+    NSUInteger *lengths = calloc(MAX(toCount, 1), sizeof(NSUInteger));
+    NSUInteger longest  = 0;
+    
+    for (NSUInteger j = 0; j < toCount; j++)
+    {
+        if (toMatches[j] == NSNotFound)
+            continue;
+        
+        lengths[j] = 1;
+        
+        for (NSUInteger k = 0; k < j; k++)
+            if (toMatches[k] != NSNotFound && toMatches[k] < toMatches[j] && lengths[k] + 1 > lengths[j])
+                lengths[j] = lengths[k] + 1;
+        
+        longest = MAX(longest, lengths[j]);
+    }
+    
+    free(lengths);
+    
+    return longest;
+}
+
+
+
+#pragma mark - Checks
+
+// Applies the change set with collection view batch update semantics: removed and moved items leave,
+// the items that stay keep their old order, and moved and inserted items land at their new indexes.
+static void KITCheckChangeSet(const NSUInteger *from, NSUInteger fromCount, const NSUInteger *to, NSUInteger toCount,
+                              KITDiff diff, const char *name)
+{
+    NSUInteger numberOfMatches = 0;
+    
+    for (NSUInteger i = 0; i < fromCount; i++)
+    {
+        NSUInteger j = diff.fromMatches[i];
+        
+        if (j == NSNotFound)
+            continue;
+        
+        numberOfMatches++;
+        
+        KITExpect(j < toCount && diff.toMatches[j] == i, "%s: old index %lu and new index %lu do not match each other", name, i, j);
+        KITExpect(j < toCount && from[i] == to[j], "%s: old index %lu is matched to a different asset", name, i);
+    }
+    
+    NSUInteger *staying = malloc(MAX(fromCount, 1) * sizeof(NSUInteger));
+    NSUInteger numberOfStaying = 0, numberOfMoves = 0, next = 0;
+    
+    for (NSUInteger i = 0; i < fromCount; i++)
+    {
+        NSUInteger j = diff.fromMatches[i];
+        
+        if (j != NSNotFound && j < toCount && diff.stays[j])
+            staying[numberOfStaying++] = from[i];
+    }
+    
+    BOOL isEqual = YES;
+    
+    for (NSUInteger j = 0; j < toCount; j++)
+    {
+        NSUInteger i = diff.toMatches[j];
+        NSUInteger symbol;
+        
+        KITExpect(!(i == NSNotFound && diff.stays[j]), "%s: inserted index %lu is marked as staying", name, j);
+        
+        if (i == NSNotFound)
+            symbol = to[j];
+        else if (!diff.stays[j])
+            symbol = from[i], numberOfMoves++;
+        else
+            symbol = (next < numberOfStaying) ? staying[next++] : NSNotFound;
+        
+        isEqual = isEqual && (symbol == to[j]);
+    }
+    
+    KITExpect(isEqual, "%s: applying the change set does not give the new snapshot", name);
+    KITExpect(next == numberOfStaying, "%s: %lu items stay but %lu places are left for them", name, numberOfStaying, next);
+    KITExpect(numberOfMoves == numberOfMatches - KITReferenceLongestRun(diff.toMatches, toCount),
+              "%s: %lu moves where fewer would do", name, numberOfMoves);
+    
+    // Heckel's first passes: an asset that occurs once in each snapshot is never removed and inserted
+    for (NSUInteger i = 0; i < fromCount; i++)
+    {
+        if (diff.fromMatches[i] == NSNotFound && KITCountOf(from[i], from, fromCount) == 1 && KITCountOf(from[i], to, toCount) == 1)
+        {
+            KITExpect(NO, "%s: unique asset %lu at old index %lu is not matched", name, from[i], i);
+            break;
+        }
+    }
+    
+    free(staying);
+}
+
+static void KITCheck(const NSUInteger *from, NSUInteger fromCount, const NSUInteger *to, NSUInteger toCount,
+                     NSUInteger numberOfSymbols, const char *name)
+{
+    KITDiff diff = KITDiffCreate(from, fromCount, to, toCount, numberOfSymbols);
+    KITCheckChangeSet(from, fromCount, to, toCount, diff, name);
+    KITDiffFree(diff);
+}
+
+
+
+#pragma mark - Tests
+
+static void testEdgeCases(void)
+{
+    NSUInteger some[]       = {0, 1, 2, 3, 4};
+    NSUInteger reversed[]   = {4, 3, 2, 1, 0};
+    NSUInteger moved[]      = {1, 2, 3, 0, 4};
+    NSUInteger repeated[]   = {5, 5, 0, 5, 1, 5};
+    
+    KITCheck(NULL, 0, NULL, 0, 0, "empty to empty");
+    KITCheck(NULL, 0, some, 5, 5, "empty to some");
+    KITCheck(some, 5, NULL, 0, 5, "some to empty");
+    KITCheck(some, 5, some, 5, 5, "identical");
+    KITCheck(some, 5, reversed, 5, 5, "reversed");
+    KITCheck(some, 5, moved, 5, 5, "one moved");
+    KITCheck(repeated, 6, some, 5, 6, "repeated to unique");
+    KITCheck(some, 5, repeated, 6, 6, "unique to repeated");
+    
+    // nothing changes, so nothing may be removed, inserted or moved
+    KITDiff diff = KITDiffCreate(some, 5, some, 5, 5);
+    
+    for (NSUInteger j = 0; j < 5; j++)
+        KITExpect(diff.toMatches[j] == j && diff.stays[j], "identical snapshots change index %lu", j);
+    
+    KITDiffFree(diff);
+    
+    // a single move, and only that one
+    diff = KITDiffCreate(some, 5, moved, 5, 5);
+    NSUInteger numberOfMoves = 0;
+    
+    for (NSUInteger j = 0; j < 5; j++)
+        numberOfMoves += !diff.stays[j];
+    
+    KITExpect(numberOfMoves == 1, "one moved asset takes %lu moves", numberOfMoves);
+    KITDiffFree(diff);
+}
+
+// random edits of random snapshots; a small alphabet repeats assets, a large one keeps most unique
+static void testRandomEdits(void)
+{
+    static const NSUInteger alphabets[] = {3, 20, 1000};
+    
+    srand(1);
+    
+    for (int round = 0; round < 3000; round++)
+    {
+        NSUInteger alphabet     = alphabets[round % 3];
+        NSUInteger fromCount    = (NSUInteger)(rand() % 120);
+        NSUInteger capacity     = fromCount * 2 + 40;
+        NSUInteger *from        = malloc(MAX(fromCount, 1) * sizeof(NSUInteger));
+        NSUInteger *to          = malloc(capacity * sizeof(NSUInteger));
+        NSUInteger toCount      = fromCount;
+        
+        for (NSUInteger i = 0; i < fromCount; i++)
+            from[i] = (NSUInteger)rand() % alphabet;
+        
+        memcpy(to, from, fromCount * sizeof(NSUInteger));
+        
+        int numberOfEdits = rand() % 12;
+        
+        for (int edit = 0; edit < numberOfEdits; edit++)
+        {
+            int kind = rand() % 3;
+            
+            if (kind == 0 && toCount > 0)
+            {
+                // remove
+                NSUInteger index = (NSUInteger)rand() % toCount;
+                memmove(to + index, to + index + 1, (toCount - index - 1) * sizeof(NSUInteger));
+                toCount--;
+            }
+            else if (kind == 1 && toCount < capacity)
+            {
+                // insert, sometimes an asset that is new to the alphabet
+                NSUInteger index = (NSUInteger)rand() % (toCount + 1);
+                memmove(to + index + 1, to + index, (toCount - index) * sizeof(NSUInteger));
+                to[index] = (rand() % 2) ? (NSUInteger)rand() % alphabet : alphabet + (NSUInteger)edit;
+                toCount++;
+            }
+            else if (toCount > 1)
+            {
+                // move
+                NSUInteger fromIndex = (NSUInteger)rand() % toCount, toIndex = (NSUInteger)rand() % toCount;
+                NSUInteger symbol = to[fromIndex];
+                memmove(to + fromIndex, to + fromIndex + 1, (toCount - fromIndex - 1) * sizeof(NSUInteger));
+                memmove(to + toIndex + 1, to + toIndex, (toCount - 1 - toIndex) * sizeof(NSUInteger));
+                to[toIndex] = symbol;
+            }
+        }
+        
+        char name[64];
+        snprintf(name, sizeof(name), "round %d", round);
+        
+        KITCheck(from, fromCount, to, toCount, alphabet + (NSUInteger)numberOfEdits, name);
+        
+        free(from);
+        free(to);
+    }
+}
+
+// completely unrelated snapshots of the same alphabet
+static void testShuffles(void)
+{
+    srand(2);
+    
+    for (int round = 0; round < 500; round++)
+    {
+        NSUInteger count = (NSUInteger)(rand() % 60) + 1;
+        NSUInteger *from = malloc(count * sizeof(NSUInteger));
+        NSUInteger *to   = malloc(count * sizeof(NSUInteger));
+        
+        for (NSUInteger i = 0; i < count; i++)
+            from[i] = to[i] = i;
+        
+        for (NSUInteger i = count - 1; i > 0; i--)
+        {
+            NSUInteger k = (NSUInteger)rand() % (i + 1), symbol = to[i];
+            to[i] = to[k];
+            to[k] = symbol;
+        }
+        
+        char name[64];
+        snprintf(name, sizeof(name), "shuffle %d", round);
+        
+        KITCheck(from, count, to, count, count, name);
+        
+        free(from);
+        free(to);
+    }
+}
+
+
+
+int main(void)
+{
+    testEdgeCases();
+    testRandomEdits();
+    testShuffles();
+    
+    printf("%s\n", (failures == 0) ? "All diff tests passed." : "Diff tests failed.");
+    
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
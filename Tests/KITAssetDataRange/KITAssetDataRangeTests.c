@@ -0,0 +1,200 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "KITAssetDataRange.h"
+
+
+
+#pragma mark - Helpers
+
+static int failures = 0;
+
+#define KITExpect(condition, ...) \
+    do { if (!(condition)) { failures++; printf("FAIL %s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); } } while (0)
+
+// an odd length, so that no chunk length divides it
+static const NSUInteger KITFileLength = 1024 * 1024 + 17;
+
+static unsigned char *KITWriteFile(const char *path)
+{
+    unsigned char *bytes = malloc(KITFileLength);
+    
+    srand(1);
+    
+    for (NSUInteger i = 0; i < KITFileLength; i++)
+        bytes[i] = (unsigned char)rand();
+    
+    FILE *file = fopen(path, "wb");
+    
+    if (!file || fwrite(bytes, 1, KITFileLength, file) != KITFileLength)
+    {
+        printf("cannot write %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+    
+    fclose(file);
+    
+    return bytes;
+}
+
+// reads the range the way KITFileAssetDataSource does and checks it against the file
+static void KITCheckRange(const char *path, const unsigned char *file, unsigned long long offset, NSUInteger length)
+{
+    unsigned char *bytes = malloc(MAX(length, 1));
+    long long count = KITAssetDataRangeReadFile(path, offset, length, bytes);
+    long long expected = (offset >= KITFileLength) ? 0 : (long long)MIN(length, KITFileLength - offset);
+    
+    KITExpect(count == expected, "range %llu+%lu read %lld bytes, expected %lld", offset, length, count, expected);
+    KITExpect(count <= 0 || memcmp(bytes, file + offset, (size_t)count) == 0, "range %llu+%lu has the wrong bytes", offset, length);
+    
+    free(bytes);
+}
+
+// reads every byte the way KITAssetDataReader does: one range after another, stopping at a short read
+static void KITCheckChunkedRead(const char *path, const unsigned char *file, NSUInteger chunkLength, BOOL knowsLength)
+{
+    long long expectedLength = (knowsLength) ? (long long)KITFileLength : -1;
+    unsigned char *copy = malloc(KITFileLength + chunkLength);
+    unsigned char *chunk = malloc(chunkLength);
+    long long offset = 0;
+    NSUInteger numberOfReads = 0;
+    
+    for (;;)
+    {
+        NSUInteger length = KITAssetDataRangeNextLength(offset, expectedLength, chunkLength);
+        
+        if (length == 0)
+            break;
+        
+        long long count = KITAssetDataRangeReadFile(path, (unsigned long long)offset, length, chunk);
+        numberOfReads++;
+        
+        if (count < 0 || offset + count > (long long)KITFileLength)
+            break;
+        
+        memcpy(copy + offset, chunk, (size_t)count);
+        offset += count;
+        
+        if ((NSUInteger)count < length)
+            break;
+    }
+    
+    // an unknown length takes one more read to find the end when the chunks divide the file
+    NSUInteger expectedReads = (KITFileLength + chunkLength - 1) / chunkLength + ((!knowsLength && KITFileLength % chunkLength == 0) ? 1 : 0);
+    
+    KITExpect(offset == (long long)KITFileLength && memcmp(copy, file, KITFileLength) == 0,
+              "chunks of %lu (%s length) rebuilt %lld of %lu bytes", chunkLength, (knowsLength) ? "known" : "unknown", offset, KITFileLength);
+    KITExpect(numberOfReads == expectedReads,
+              "chunks of %lu (%s length) took %lu reads, expected %lu", chunkLength, (knowsLength) ? "known" : "unknown", numberOfReads, expectedReads);
+    
+    free(copy);
+    free(chunk);
+}
+
+
+
+#pragma mark - Tests
+
+static void testNextLength(void)
+{
+    KITExpect(KITAssetDataRangeNextLength(0, 1000, 256) == 256, "a full chunk");
+    KITExpect(KITAssetDataRangeNextLength(768, 1000, 256) == 232, "the last chunk is clipped");
+    KITExpect(KITAssetDataRangeNextLength(1000, 1000, 256) == 0, "nothing past the end");
+    KITExpect(KITAssetDataRangeNextLength(0, 0, 256) == 0, "nothing in an empty asset");
+    KITExpect(KITAssetDataRangeNextLength(5000, -1, 256) == 256, "full chunks when the length is unknown");
+}
+
+static void testRanges(const char *path, const unsigned char *file)
+{
+    KITCheckRange(path, file, 0, 0);
+    KITCheckRange(path, file, 0, 1);
+    KITCheckRange(path, file, 0, KITFileLength);
+    KITCheckRange(path, file, 12345, 65536);
+    KITCheckRange(path, file, KITFileLength - 1, 1);
+    
+    // past and across the end are short reads, not errors
+    KITCheckRange(path, file, KITFileLength - 10, 100);
+    KITCheckRange(path, file, KITFileLength, 100);
+    KITCheckRange(path, file, KITFileLength + 4096, 100);
+    
+    srand(2);
+    
+    for (int i = 0; i < 200; i++)
+        KITCheckRange(path, file, (unsigned long long)rand() % (KITFileLength + 100), (NSUInteger)rand() % 300000);
+    
+    unsigned char byte;
+    errno = 0;
+    
+    KITExpect(KITAssetDataRangeReadFile("/nonexistent/asset.bin", 0, 1, &byte) == -1 && errno == ENOENT, "a missing file is an error");
+}
+
+// a header read only touches the prefix, whatever the size of the file
+static void testPrefixes(const char *path, const unsigned char *file)
+{
+    static const NSUInteger lengths[] = {0, 1, 12, 64 * 1024, 256 * 1024};
+    
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+        KITCheckRange(path, file, 0, lengths[i]);
+    
+    // longer than the file gives the whole file
+    KITCheckRange(path, file, 0, KITFileLength * 2);
+}
+
+static void testChunkedReads(const char *path, const unsigned char *file)
+{
+    static const NSUInteger chunkLengths[] = {1000, 4096, 256 * 1024, KITFileLength, KITFileLength + 1};
+    
+    for (size_t i = 0; i < sizeof(chunkLengths) / sizeof(chunkLengths[0]); i++)
+    {
+        KITCheckChunkedRead(path, file, chunkLengths[i], YES);
+        KITCheckChunkedRead(path, file, chunkLengths[i], NO);
+    }
+}
+
+
+
+int main(int argc, char **argv)
+{
+    const char *path = (argc > 1) ? argv[1] : "asset.bin";
+    unsigned char *file = KITWriteFile(path);
+    
+    testNextLength();
+    testRanges(path, file);
+    testPrefixes(path, file);
+    testChunkedReads(path, file);
+    
+    free(file);
+    remove(path);
+    
+    printf("%s\n", (failures == 0) ? "All data range tests passed." : "Data range tests failed.");
+    
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,100 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "KITAssetImageResampler.h"
+
+
+
+// a 12 MP photo down to grid thumbnail and screen sizes
+static const size_t KITBenchmarkSourceWidth  = 4032;
+static const size_t KITBenchmarkSourceHeight = 3024;
+static const int KITBenchmarkIterations      = 5;
+
+
+
+static double KITBenchmarkNow(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static void KITBenchmarkRun(const uint8_t *src, size_t dstWidth, size_t dstHeight, KITAssetImageResamplerFilter filter, const char *name)
+{
+    uint8_t *dst = malloc(dstWidth * dstHeight * 4);
+    
+    // warm up caches and the allocator
+    KITAssetImageResample(src, KITBenchmarkSourceWidth, KITBenchmarkSourceHeight, KITBenchmarkSourceWidth * 4,
+                          dst, dstWidth, dstHeight, dstWidth * 4, filter);
+    
+    double best = 1e9;
+    
+    for (int i = 0; i < KITBenchmarkIterations; i++)
+    {
+        double start = KITBenchmarkNow();
+        
+        KITAssetImageResample(src, KITBenchmarkSourceWidth, KITBenchmarkSourceHeight, KITBenchmarkSourceWidth * 4,
+                              dst, dstWidth, dstHeight, dstWidth * 4, filter);
+        
+        double elapsed = KITBenchmarkNow() - start;
+        best = (elapsed < best) ? elapsed : best;
+    }
+    
+    double megapixels = KITBenchmarkSourceWidth * KITBenchmarkSourceHeight / 1e6;
+    
+    printf("%-9s %4zux%-4zu -> %4zux%-4zu  %8.2f ms  %8.1f MP/s\n", name,
+           KITBenchmarkSourceWidth, KITBenchmarkSourceHeight, dstWidth, dstHeight, best * 1e3, megapixels / best);
+    
+    free(dst);
+}
+
+int main(void)
+{
+    size_t length   = KITBenchmarkSourceWidth * KITBenchmarkSourceHeight * 4;
+    uint8_t *src    = malloc(length);
+    
+    srand(1);
+    
+    for (size_t i = 0; i < length; i++)
+        src[i] = (uint8_t)(rand() & 0xFF);
+    
+    static const size_t sizes[][2] = {{256, 192}, {512, 384}, {1334, 1000}};
+    
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        KITBenchmarkRun(src, sizes[i][0], sizes[i][1], KITAssetImageResamplerFilterBox, "box");
+        KITBenchmarkRun(src, sizes[i][0], sizes[i][1], KITAssetImageResamplerFilterLanczos3, "lanczos3");
+    }
+    
+    free(src);
+    
+    return EXIT_SUCCESS;
+}
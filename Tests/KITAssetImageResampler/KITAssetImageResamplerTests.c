@@ -0,0 +1,301 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "KITAssetImageResampler.h"
+
+
+
+#pragma mark - Reference
+
+// A direct, double-precision resampler written from the filter definitions: every destination pixel sums
+// the weights of all source pixels under its footprint, clipped to the image and normalised per axis.
+
+static double KITReferenceSinc(double x)
+{
+    if (x == 0)
+        return 1;
+    
+    x *= M_PI;
+    return sin(x) / x;
+}
+
+static double KITReferenceWeight(double x, double center, double scale, KITAssetImageResamplerFilter filter)
+{
+    double filterScale = (scale > 1) ? scale : 1;
+    
+    if (filter == KITAssetImageResamplerFilterLanczos3)
+    {
+        double t = (x + 0.5 - center) / filterScale;
+        return (fabs(t) < 3) ? KITReferenceSinc(t) * KITReferenceSinc(t / 3) : 0;
+    }
+    
+    // the area of source pixel [x, x + 1] inside the footprint
+    double from = center - 0.5 * filterScale;
+    double to   = center + 0.5 * filterScale;
+    double w    = fmin(x + 1, to) - fmax(x, from);
+    
+    return (w > 0) ? w : 0;
+}
+
+static double *KITReferenceWeights(size_t inSize, size_t outSize, KITAssetImageResamplerFilter filter)
+{
+    double scale    = (double)inSize / (double)outSize;
+    double *weights = calloc(inSize * outSize, sizeof(double));
+    
+    for (size_t out = 0; out < outSize; out++)
+    {
+        double center   = (out + 0.5) * scale;
+        double total    = 0;
+        
+        for (size_t in = 0; in < inSize; in++)
+            total += weights[out * inSize + in] = KITReferenceWeight(in, center, scale, filter);
+        
+        for (size_t in = 0; in < inSize && total != 0; in++)
+            weights[out * inSize + in] /= total;
+    }
+    
+    return weights;
+}
+
+static void KITReferenceResample(const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcBytesPerRow,
+                                 uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstBytesPerRow,
+                                 KITAssetImageResamplerFilter filter)
+{
+    double *horizontal  = KITReferenceWeights(srcWidth, dstWidth, filter);
+    double *vertical    = KITReferenceWeights(srcHeight, dstHeight, filter);
+    
+    for (size_t y = 0; y < dstHeight; y++)
+    {
+        for (size_t x = 0; x < dstWidth; x++)
+        {
+            for (size_t channel = 0; channel < 4; channel++)
+            {
+                double value = 0;
+                
+                for (size_t sy = 0; sy < srcHeight; sy++)
+                {
+                    double wy = vertical[y * srcHeight + sy];
+                    
+                    if (wy == 0)
+                        continue;
+                    
+                    for (size_t sx = 0; sx < srcWidth; sx++)
+                        value += wy * horizontal[x * srcWidth + sx] * src[sy * srcBytesPerRow + sx * 4 + channel];
+                }
+                
+                value = (value < 0) ? 0 : (value > 255) ? 255 : value;
+                dst[y * dstBytesPerRow + x * 4 + channel] = (uint8_t)floor(value + 0.5);
+            }
+        }
+    }
+    
+    free(horizontal);
+    free(vertical);
+}
+
+
+
+#pragma mark - Helpers
+
+static int failures = 0;
+
+#define KITExpect(condition, ...) \
+    do { if (!(condition)) { failures++; printf("FAIL %s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); } } while (0)
+
+static uint8_t *KITRandomImage(size_t width, size_t height, size_t bytesPerRow, unsigned int seed)
+{
+    uint8_t *image = malloc(height * bytesPerRow);
+    
+    srand(seed);
+    
+    for (size_t i = 0; i < height * bytesPerRow; i++)
+        image[i] = (uint8_t)(rand() & 0xFF);
+    
+    return image;
+}
+
+static int KITMaximumDifference(const uint8_t *a, const uint8_t *b, size_t width, size_t height, size_t bytesPerRow)
+{
+    int maximum = 0;
+    
+    for (size_t y = 0; y < height; y++)
+    {
+        for (size_t i = 0; i < width * 4; i++)
+        {
+            int difference = abs((int)a[y * bytesPerRow + i] - (int)b[y * bytesPerRow + i]);
+            maximum = (difference > maximum) ? difference : maximum;
+        }
+    }
+    
+    return maximum;
+}
+
+static const char *KITFilterName(KITAssetImageResamplerFilter filter)
+{
+    return (filter == KITAssetImageResamplerFilterLanczos3) ? "lanczos3" : "box";
+}
+
+
+
+#pragma mark - Tests
+
+// single-precision accumulation may round differently from the reference, by one level at most
+static void testMatchesReference(KITAssetImageResamplerFilter filter)
+{
+    static const size_t sizes[][4] = {
+        {97, 61, 13, 7},        // uneven downscale
+        {640, 480, 100, 75},    // large factor
+        {64, 64, 32, 32},       // exact halving
+        {50, 40, 49, 39},       // barely smaller
+        {31, 17, 1, 1},         // a single pixel
+        {300, 2, 7, 1},         // a single row
+        {2, 3, 5, 7},           // upscale
+        {16, 9, 16, 9},         // same size
+    };
+    
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        size_t srcWidth = sizes[i][0], srcHeight = sizes[i][1], dstWidth = sizes[i][2], dstHeight = sizes[i][3];
+        
+        uint8_t *src        = KITRandomImage(srcWidth, srcHeight, srcWidth * 4, (unsigned int)i + 1);
+        uint8_t *dst        = calloc(dstHeight, dstWidth * 4);
+        uint8_t *expected   = calloc(dstHeight, dstWidth * 4);
+        
+        BOOL success = KITAssetImageResample(src, srcWidth, srcHeight, srcWidth * 4, dst, dstWidth, dstHeight, dstWidth * 4, filter);
+        KITReferenceResample(src, srcWidth, srcHeight, srcWidth * 4, expected, dstWidth, dstHeight, dstWidth * 4, filter);
+        
+        int difference = KITMaximumDifference(dst, expected, dstWidth, dstHeight, dstWidth * 4);
+        
+        KITExpect(success, "%s %zux%zu -> %zux%zu failed", KITFilterName(filter), srcWidth, srcHeight, dstWidth, dstHeight);
+        KITExpect(difference <= 1, "%s %zux%zu -> %zux%zu differs from the reference by %d",
+                  KITFilterName(filter), srcWidth, srcHeight, dstWidth, dstHeight, difference);
+        
+        free(src);
+        free(dst);
+        free(expected);
+    }
+}
+
+static void testKeepsConstantImage(KITAssetImageResamplerFilter filter)
+{
+    size_t srcWidth = 123, srcHeight = 77, dstWidth = 19, dstHeight = 11;
+    
+    uint8_t *src = malloc(srcWidth * srcHeight * 4);
+    uint8_t *dst = calloc(dstHeight, dstWidth * 4);
+    
+    for (size_t i = 0; i < srcWidth * srcHeight; i++)
+        memcpy(src + i * 4, (uint8_t[]){200, 100, 0, 255}, 4);
+    
+    KITAssetImageResample(src, srcWidth, srcHeight, srcWidth * 4, dst, dstWidth, dstHeight, dstWidth * 4, filter);
+    
+    for (size_t i = 0; i < dstWidth * dstHeight; i++)
+    {
+        const uint8_t *pixel = dst + i * 4;
+        KITExpect(pixel[0] == 200 && pixel[1] == 100 && pixel[2] == 0 && pixel[3] == 255,
+                  "%s changes a constant image at pixel %zu: %u %u %u %u", KITFilterName(filter), i, pixel[0], pixel[1], pixel[2], pixel[3]);
+    }
+    
+    free(src);
+    free(dst);
+}
+
+static void testCopiesSameSizeBox(void)
+{
+    size_t width = 33, height = 21;
+    
+    uint8_t *src = KITRandomImage(width, height, width * 4, 7);
+    uint8_t *dst = calloc(height, width * 4);
+    
+    KITAssetImageResample(src, width, height, width * 4, dst, width, height, width * 4, KITAssetImageResamplerFilterBox);
+    
+    KITExpect(memcmp(src, dst, width * height * 4) == 0, "box at the same size does not copy the image");
+    
+    free(src);
+    free(dst);
+}
+
+// rows wider than the pixels they hold, the padding of the destination left alone
+static void testHonoursStrides(KITAssetImageResamplerFilter filter)
+{
+    size_t srcWidth = 45, srcHeight = 30, srcBytesPerRow = srcWidth * 4 + 20;
+    size_t dstWidth = 10, dstHeight = 6, dstBytesPerRow = dstWidth * 4 + 12;
+    
+    uint8_t *src        = KITRandomImage(srcWidth, srcHeight, srcBytesPerRow, 11);
+    uint8_t *dst        = malloc(dstHeight * dstBytesPerRow);
+    uint8_t *expected   = calloc(dstHeight, dstBytesPerRow);
+    
+    memset(dst, 0xAB, dstHeight * dstBytesPerRow);
+    
+    KITAssetImageResample(src, srcWidth, srcHeight, srcBytesPerRow, dst, dstWidth, dstHeight, dstBytesPerRow, filter);
+    KITReferenceResample(src, srcWidth, srcHeight, srcBytesPerRow, expected, dstWidth, dstHeight, dstBytesPerRow, filter);
+    
+    int difference = KITMaximumDifference(dst, expected, dstWidth, dstHeight, dstBytesPerRow);
+    KITExpect(difference <= 1, "%s with padded rows differs from the reference by %d", KITFilterName(filter), difference);
+    
+    for (size_t y = 0; y < dstHeight; y++)
+        for (size_t i = dstWidth * 4; i < dstBytesPerRow; i++)
+            KITExpect(dst[y * dstBytesPerRow + i] == 0xAB, "%s writes into the row padding at row %zu", KITFilterName(filter), y);
+    
+    free(src);
+    free(dst);
+    free(expected);
+}
+
+static void testRejectsEmptySizes(void)
+{
+    uint8_t pixel[4] = {0};
+    
+    KITExpect(!KITAssetImageResample(NULL, 1, 1, 4, pixel, 1, 1, 4, KITAssetImageResamplerFilterBox), "accepts a NULL source");
+    KITExpect(!KITAssetImageResample(pixel, 1, 1, 4, NULL, 1, 1, 4, KITAssetImageResamplerFilterBox), "accepts a NULL destination");
+    KITExpect(!KITAssetImageResample(pixel, 0, 1, 4, pixel, 1, 1, 4, KITAssetImageResamplerFilterBox), "accepts an empty source");
+    KITExpect(!KITAssetImageResample(pixel, 1, 1, 4, pixel, 1, 0, 4, KITAssetImageResamplerFilterBox), "accepts an empty destination");
+}
+
+
+
+int main(void)
+{
+    static const KITAssetImageResamplerFilter filters[] = {KITAssetImageResamplerFilterBox, KITAssetImageResamplerFilterLanczos3};
+    
+    for (size_t i = 0; i < sizeof(filters) / sizeof(filters[0]); i++)
+    {
+        testMatchesReference(filters[i]);
+        testKeepsConstantImage(filters[i]);
+        testHonoursStrides(filters[i]);
+    }
+    
+    testCopiesSameSizeBox();
+    testRejectsEmptySizes();
+    
+    printf("%s\n", (failures == 0) ? "All resampler tests passed." : "Resampler tests failed.");
+    
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,147 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "KITAssetsGridViewLayoutGeometry.h"
+
+
+
+static const int KITBenchmarkIterations = 5;
+
+// an iPhone in portrait: four columns under a navigation bar and above a toolbar
+static const KITAssetsGridViewLayoutMetrics KITBenchmarkMetrics = {4, 92.75, 0.5, 0, 62, 0, 0, YES};
+static const CGFloat KITBenchmarkViewportHeight = 667;
+static const CGFloat KITBenchmarkInsetTop       = 64;
+static const CGFloat KITBenchmarkInsetBottom    = 44;
+
+
+
+static double KITBenchmarkNow(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// what a flow layout does before it can scroll to the last item: a frame for every item, top to bottom
+static CGFloat KITBenchmarkLayOutEveryItem(const KITAssetsGridViewLayoutSection *sections, NSInteger numberOfSections, CGFloat *tops)
+{
+    KITAssetsGridViewLayoutMetrics metrics = KITBenchmarkMetrics;
+    CGFloat y = 0;
+    NSUInteger index = 0;
+    
+    for (NSInteger section = 0; section < numberOfSections; section++)
+    {
+        y += metrics.headerHeight + metrics.sectionInsetTop;
+        
+        for (NSInteger item = 0; item < sections[section].numberOfItems; item++)
+        {
+            if (item > 0 && item % metrics.numberOfColumns == 0)
+                y += metrics.itemHeight + metrics.lineSpacing;
+            
+            tops[index++] = y;
+        }
+        
+        if (sections[section].numberOfItems > 0)
+            y += metrics.itemHeight;
+        
+        y += metrics.sectionInsetBottom;
+        
+        if (KITAssetsGridViewLayoutShowsFooter(metrics, section, numberOfSections))
+            y += metrics.footerHeight;
+    }
+    
+    return y;
+}
+
+// sections by day hold about as many photos as a camera roll does; no sections at all when itemsPerSection is 0
+static void KITBenchmarkRun(NSUInteger count, NSInteger itemsPerSection)
+{
+    NSInteger numberOfSections = (itemsPerSection > 0) ? (NSInteger)((count + itemsPerSection - 1) / itemsPerSection) : 1;
+    KITAssetsGridViewLayoutSection *sections = calloc(numberOfSections, sizeof(KITAssetsGridViewLayoutSection));
+    CGFloat *tops = malloc(count * sizeof(CGFloat));
+    
+    for (NSInteger section = 0; section < numberOfSections; section++)
+        sections[section].numberOfItems = (itemsPerSection > 0) ? MIN(itemsPerSection, (NSInteger)count - section * itemsPerSection) : (NSInteger)count;
+    
+    double anchored = 1e9, everyItem = 1e9;
+    NSInteger itemsOnScreen = 0;
+    volatile CGFloat sink = 0;
+    
+    for (int i = 0; i < KITBenchmarkIterations; i++)
+    {
+        double start = KITBenchmarkNow();
+        
+        // the grid's open path: place the sections, jump to the end, lay out the bottom screen only
+        CGFloat contentHeight = KITAssetsGridViewLayoutPlaceSections(sections, numberOfSections, KITBenchmarkMetrics);
+        CGFloat offset = KITAssetsGridViewLayoutBottomOffset(contentHeight, KITBenchmarkViewportHeight, KITBenchmarkInsetTop, KITBenchmarkInsetBottom);
+        CGFloat maxY = offset + KITBenchmarkViewportHeight;
+        
+        itemsOnScreen = 0;
+        
+        for (NSInteger section = KITAssetsGridViewLayoutSectionAtOffset(sections, numberOfSections, offset);
+             section < numberOfSections && sections[section].top < maxY; section++)
+        {
+            NSInteger firstItem, lastItem;
+            
+            if (KITAssetsGridViewLayoutItemsInBand(&sections[section], KITBenchmarkMetrics, offset, maxY, &firstItem, &lastItem))
+                itemsOnScreen += lastItem - firstItem + 1;
+        }
+        
+        double elapsed = KITBenchmarkNow() - start;
+        anchored = (elapsed < anchored) ? elapsed : anchored;
+        
+        start = KITBenchmarkNow();
+        sink += KITBenchmarkLayOutEveryItem(sections, numberOfSections, tops);
+        elapsed = KITBenchmarkNow() - start;
+        everyItem = (elapsed < everyItem) ? elapsed : everyItem;
+    }
+    
+    printf("%8lu items  %6ld sections  %8.1f us anchored, %ld items laid out  %8.1f us laying out every item\n",
+           count, numberOfSections, anchored * 1e6, itemsOnScreen, everyItem * 1e6);
+    
+    free(sections);
+    free(tops);
+}
+
+int main(void)
+{
+    static const NSUInteger counts[] = {10000, 100000, 1000000};
+    
+    printf("arithmetic only; building cells and requesting their thumbnails is not measured here\n");
+    
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+    {
+        KITBenchmarkRun(counts[i], 0);
+        KITBenchmarkRun(counts[i], 30);
+    }
+    
+    return EXIT_SUCCESS;
+}
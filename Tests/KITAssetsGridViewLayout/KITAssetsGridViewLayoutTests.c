@@ -0,0 +1,283 @@
+/*
+ 
+ MIT License (MIT)
+ 
+ Copyright (c) 2016 Kite.ly
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ 
+ */
+
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "KITAssetsGridViewLayoutGeometry.h"
+
+
+
+#pragma mark - Helpers
+
+static int failures = 0;
+
+#define KITExpect(condition, ...) \
+    do { if (!(condition)) { failures++; printf("FAIL %s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); } } while (0)
+
+static CGFloat KITRandomLength(int max)
+{
+    return (rand() % (max * 4 + 1)) / 4.0;
+}
+
+static KITAssetsGridViewLayoutMetrics KITRandomMetrics(void)
+{
+    KITAssetsGridViewLayoutMetrics metrics;
+    
+    metrics.numberOfColumns                 = 1 + rand() % 7;
+    metrics.itemHeight                      = 1 + KITRandomLength(120);
+    metrics.lineSpacing                     = KITRandomLength(4);
+    metrics.headerHeight                    = (rand() % 2) ? KITRandomLength(44) : 0;
+    metrics.footerHeight                    = (rand() % 2) ? KITRandomLength(60) : 0;
+    metrics.sectionInsetTop                 = KITRandomLength(8);
+    metrics.sectionInsetBottom              = KITRandomLength(8);
+    metrics.showsFooterInLastSectionOnly    = rand() % 2;
+    
+    return metrics;
+}
+
+static KITAssetsGridViewLayoutSection *KITRandomSections(NSInteger numberOfSections, int maxItems)
+{
+    KITAssetsGridViewLayoutSection *sections = calloc(MAX(numberOfSections, 1), sizeof(KITAssetsGridViewLayoutSection));
+    
+    for (NSInteger section = 0; section < numberOfSections; section++)
+        sections[section].numberOfItems = (rand() % 8 == 0) ? 0 : rand() % (maxItems + 1);
+    
+    return sections;
+}
+
+// the top of an item, found by walking every item of every section before it as flow layout would
+static CGFloat KITReferenceItemTop(const KITAssetsGridViewLayoutSection *sections, NSInteger numberOfSections,
+                                   KITAssetsGridViewLayoutMetrics metrics, NSInteger itemSection, NSInteger itemIndex,
+                                   CGFloat *contentHeight)
+{
+    CGFloat y = 0;
+    CGFloat itemTop = NAN;
+    
+    for (NSInteger section = 0; section < numberOfSections; section++)
+    {
+        y += metrics.headerHeight + metrics.sectionInsetTop;
+        
+        CGFloat rowTop = y;
+        CGFloat rowBottom = y;
+        
+        for (NSInteger item = 0; item < sections[section].numberOfItems; item++)
+        {
+            if (item > 0 && item % metrics.numberOfColumns == 0)
+                rowTop = rowBottom + metrics.lineSpacing;
+            
+            rowBottom = rowTop + metrics.itemHeight;
+            
+            if (section == itemSection && item == itemIndex)
+                itemTop = rowTop;
+        }
+        
+        y = rowBottom + metrics.sectionInsetBottom;
+        
+        if (metrics.footerHeight > 0 && (!metrics.showsFooterInLastSectionOnly || section == numberOfSections - 1))
+            y += metrics.footerHeight;
+    }
+    
+    if (contentHeight)
+        *contentHeight = y;
+    
+    return itemTop;
+}
+
+static BOOL KITNearlyEqual(CGFloat a, CGFloat b)
+{
+    return fabs(a - b) < 1e-6;
+}
+
+
+
+#pragma mark - Tests
+
+static void testPlaceSections(void)
+{
+    srand(1);
+    
+    for (int round = 0; round < 500; round++)
+    {
+        NSInteger numberOfSections = rand() % 6;
+        KITAssetsGridViewLayoutMetrics metrics = KITRandomMetrics();
+        KITAssetsGridViewLayoutSection *sections = KITRandomSections(numberOfSections, 40);
+        
+        CGFloat contentHeight = KITAssetsGridViewLayoutPlaceSections(sections, numberOfSections, metrics);
+        CGFloat referenceHeight;
+        
+        KITReferenceItemTop(sections, numberOfSections, metrics, -1, -1, &referenceHeight);
+        KITExpect(KITNearlyEqual(contentHeight, referenceHeight), "round %d: content height %g, expected %g", round, contentHeight, referenceHeight);
+        
+        for (NSInteger section = 0; section < numberOfSections; section++)
+        {
+            const KITAssetsGridViewLayoutSection *info = &sections[section];
+            
+            KITExpect(info->numberOfRows * metrics.numberOfColumns >= info->numberOfItems &&
+                      (info->numberOfRows - 1) * metrics.numberOfColumns < MAX(info->numberOfItems, 1),
+                      "round %d: %ld rows for %ld items", round, info->numberOfRows, info->numberOfItems);
+            
+            KITExpect(info->itemsTop >= info->top && info->bottom >= info->itemsTop,
+                      "round %d: section %ld out of order", round, section);
+            
+            if (section > 0)
+                KITExpect(KITNearlyEqual(info->top, sections[section - 1].bottom), "round %d: gap before section %ld", round, section);
+            
+            for (NSInteger item = 0; item < info->numberOfItems; item++)
+            {
+                CGFloat top = info->itemsTop + (item / metrics.numberOfColumns) * (metrics.itemHeight + metrics.lineSpacing);
+                CGFloat referenceTop = KITReferenceItemTop(sections, numberOfSections, metrics, section, item, NULL);
+                
+                KITExpect(KITNearlyEqual(top, referenceTop), "round %d: item %ld.%ld at %g, expected %g", round, section, item, top, referenceTop);
+            }
+        }
+        
+        free(sections);
+    }
+}
+
+static void testSectionAtOffset(void)
+{
+    srand(2);
+    
+    KITExpect(KITAssetsGridViewLayoutSectionAtOffset(NULL, 0, 0) == NSNotFound, "no sections");
+    
+    for (int round = 0; round < 200; round++)
+    {
+        NSInteger numberOfSections = 1 + rand() % 20;
+        KITAssetsGridViewLayoutMetrics metrics = KITRandomMetrics();
+        KITAssetsGridViewLayoutSection *sections = KITRandomSections(numberOfSections, 30);
+        CGFloat contentHeight = KITAssetsGridViewLayoutPlaceSections(sections, numberOfSections, metrics);
+        
+        for (int probe = 0; probe < 50; probe++)
+        {
+            // half the probes land exactly on a section boundary
+            CGFloat offset = (probe % 2) ? sections[rand() % numberOfSections].top : ((CGFloat)rand() / RAND_MAX) * (contentHeight + 200) - 100;
+            NSInteger expected = 0;
+            
+            // the last section starting at or above the offset, as a linear scan finds it
+            for (NSInteger section = 0; section < numberOfSections; section++)
+            {
+                if (sections[section].top <= offset)
+                    expected = section;
+            }
+            
+            NSInteger section = KITAssetsGridViewLayoutSectionAtOffset(sections, numberOfSections, offset);
+            KITExpect(section == expected, "round %d: offset %g in section %ld, expected %ld", round, offset, section, expected);
+        }
+        
+        free(sections);
+    }
+}
+
+static void testItemsInBand(void)
+{
+    srand(3);
+    
+    for (int round = 0; round < 300; round++)
+    {
+        NSInteger numberOfSections = 1 + rand() % 4;
+        KITAssetsGridViewLayoutMetrics metrics = KITRandomMetrics();
+        KITAssetsGridViewLayoutSection *sections = KITRandomSections(numberOfSections, 60);
+        CGFloat contentHeight = KITAssetsGridViewLayoutPlaceSections(sections, numberOfSections, metrics);
+        CGFloat rowHeight = metrics.itemHeight + metrics.lineSpacing;
+        
+        for (int probe = 0; probe < 20; probe++)
+        {
+            CGFloat minY = ((CGFloat)rand() / RAND_MAX) * contentHeight;
+            CGFloat maxY = minY + ((CGFloat)rand() / RAND_MAX) * contentHeight / 2;
+            
+            for (NSInteger section = 0; section < numberOfSections; section++)
+            {
+                const KITAssetsGridViewLayoutSection *info = &sections[section];
+                NSInteger firstItem = -1, lastItem = -1;
+                BOOL found = KITAssetsGridViewLayoutItemsInBand(info, metrics, minY, maxY, &firstItem, &lastItem);
+                
+                // every item whose frame overlaps the band has to be in the range, which may add at most a row on either end
+                for (NSInteger item = 0; item < info->numberOfItems; item++)
+                {
+                    NSInteger row = item / metrics.numberOfColumns;
+                    CGFloat top = info->itemsTop + row * rowHeight;
+                    BOOL overlaps = (top < maxY && top + metrics.itemHeight > minY);
+                    
+                    if (overlaps)
+                        KITExpect(found && item >= firstItem && item <= lastItem,
+                                  "round %d: item %ld.%ld overlaps [%g, %g) but range is %ld-%ld", round, section, item, minY, maxY, firstItem, lastItem);
+                }
+                
+                if (found)
+                {
+                    KITExpect(firstItem % metrics.numberOfColumns == 0 && firstItem <= lastItem && lastItem < info->numberOfItems,
+                              "round %d: bad range %ld-%ld", round, firstItem, lastItem);
+                    
+                    CGFloat firstTop = info->itemsTop + (firstItem / metrics.numberOfColumns) * rowHeight;
+                    CGFloat lastTop  = info->itemsTop + (lastItem / metrics.numberOfColumns) * rowHeight;
+                    
+                    KITExpect(firstTop + rowHeight > minY && lastTop <= maxY,
+                              "round %d: range %ld-%ld reaches past [%g, %g)", round, firstItem, lastItem, minY, maxY);
+                }
+            }
+        }
+        
+        free(sections);
+    }
+}
+
+static void testBottomOffset(void)
+{
+    KITExpect(KITAssetsGridViewLayoutBottomOffset(100, 600, 64, 44) == -64, "short content stays at the top");
+    KITExpect(KITAssetsGridViewLayoutBottomOffset(1000, 600, 64, 44) == 444, "long content ends above the bottom inset");
+    
+    // the bottom screen of a large grid holds the last item and no more than a screen of rows
+    KITAssetsGridViewLayoutMetrics metrics = {4, 92.75, 0.5, 0, 62, 0, 0, YES};
+    KITAssetsGridViewLayoutSection section = {100000};
+    CGFloat contentHeight = KITAssetsGridViewLayoutPlaceSections(&section, 1, metrics);
+    CGFloat viewportHeight = 667, insetTop = 64, insetBottom = 44;
+    CGFloat offset = KITAssetsGridViewLayoutBottomOffset(contentHeight, viewportHeight, insetTop, insetBottom);
+    NSInteger firstItem, lastItem;
+    
+    BOOL found = KITAssetsGridViewLayoutItemsInBand(&section, metrics, offset, offset + viewportHeight, &firstItem, &lastItem);
+    NSInteger rowsOnScreen = (NSInteger)ceil(viewportHeight / (metrics.itemHeight + metrics.lineSpacing)) + 1;
+    
+    KITExpect(found && lastItem == 99999, "the last item is on the bottom screen");
+    KITExpect(found && lastItem - firstItem + 1 <= rowsOnScreen * metrics.numberOfColumns,
+              "%ld items on the bottom screen", lastItem - firstItem + 1);
+}
+
+
+
+int main(void)
+{
+    testPlaceSections();
+    testSectionAtOffset();
+    testItemsInBand();
+    testBottomOffset();
+    
+    printf("%s\n", (failures == 0) ? "All grid layout tests passed." : "Grid layout tests failed.");
+    
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,28 @@
+/*
+ *  The few Foundation definitions the plain C parts of the picker use, so that they
+ *  build as plain C for the tests on any platform.
+ */
+
+#ifndef KIT_FOUNDATION_SHIM_H
+#define KIT_FOUNDATION_SHIM_H
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef signed char BOOL;
+typedef long NSInteger;
+typedef unsigned long NSUInteger;
+typedef double CGFloat;
+
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+
+#define NSNotFound ((NSInteger)LONG_MAX)
+
+#define NS_ENUM(type, name) type name; enum
+
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+
+#endif